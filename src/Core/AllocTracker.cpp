@@ -0,0 +1,95 @@
+#include "AllocTracker.h"
+
+#ifdef BOCCHI_ALLOC_TRACKING
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#endif
+
+namespace Bocchi::AllocTracker {
+
+    namespace {
+        thread_local Counters t_counters;
+    }
+
+    Counters threadCounters() {
+        return t_counters;
+    }
+
+#ifdef BOCCHI_ALLOC_TRACKING
+    namespace {
+        void* trackedAlloc(std::size_t size) {
+            t_counters.count++;
+            t_counters.bytes += size;
+            return std::malloc(size ? size : 1);
+        }
+
+        // 对齐版本：MSVC 没有 std::aligned_alloc，且对齐块必须用 _aligned_free 释放
+        void* trackedAlignedAlloc(std::size_t size, std::size_t align) {
+            t_counters.count++;
+            t_counters.bytes += size;
+            size = size ? (size + align - 1) / align * align : align;
+#ifdef _WIN32
+            return _aligned_malloc(size, align);
+#else
+            return std::aligned_alloc(align, size);
+#endif
+        }
+
+        void alignedFree(void* p) noexcept {
+#ifdef _WIN32
+            _aligned_free(p);
+#else
+            std::free(p);
+#endif
+        }
+    }
+#endif
+}
+
+#ifdef BOCCHI_ALLOC_TRACKING
+// 普通、nothrow 与 align_val_t 版本全部替换，超对齐分配同样计入统计
+void* operator new(std::size_t size) {
+    if (void* p = Bocchi::AllocTracker::trackedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = Bocchi::AllocTracker::trackedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return Bocchi::AllocTracker::trackedAlloc(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return Bocchi::AllocTracker::trackedAlloc(size);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* p = Bocchi::AllocTracker::trackedAlignedAlloc(size, static_cast<std::size_t>(align))) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    if (void* p = Bocchi::AllocTracker::trackedAlignedAlloc(size, static_cast<std::size_t>(align))) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return Bocchi::AllocTracker::trackedAlignedAlloc(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return Bocchi::AllocTracker::trackedAlignedAlloc(size, static_cast<std::size_t>(align));
+}
+void operator delete(void* p, std::align_val_t) noexcept { Bocchi::AllocTracker::alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { Bocchi::AllocTracker::alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { Bocchi::AllocTracker::alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { Bocchi::AllocTracker::alignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { Bocchi::AllocTracker::alignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { Bocchi::AllocTracker::alignedFree(p); }
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+namespace Bocchi {
+
+    // 堆分配计数：CMake 选项 BOCCHI_ALLOC_TRACKING 打开时替换全局 operator new，
+    // 按线程累计次数与字节数；关闭时计数恒为 0
+    namespace AllocTracker {
+        struct Counters {
+            uint64_t count = 0;
+            uint64_t bytes = 0;
+        };
+
+#ifdef BOCCHI_ALLOC_TRACKING
+        inline constexpr bool enabled = true;
+#else
+        inline constexpr bool enabled = false;
+#endif
+
+        // 当前线程至今的累计值，取两次差值得到区间内的分配
+        Counters threadCounters();
+
+        inline Counters operator-(const Counters& a, const Counters& b) {
+            return {a.count - b.count, a.bytes - b.bytes};
+        }
+    }
+}
@@ -1,7 +1,13 @@
 ﻿#include "App.h"
 #include "ResourceManager.h"
+#include "AssetArchive.h"
+#include "StartupTrace.h"
+#include <cassert>
+#include <iostream>
+#include <algorithm>
 #include "Config.h"
 #include "Game/Worlds/TestWorld.h"
+#include "Game/Worlds/LoadingWorld.h"
 #include <SFML/Window.hpp>
 
 namespace Bocchi {
@@ -9,6 +15,8 @@ namespace Bocchi {
     namespace {
         std::unique_ptr<World> createWorld(WorldType type) {
             switch(type) {
+                case WorldType::Loading:
+                    return std::make_unique<LoadingWorld>();
                 case WorldType::MainMenu:
                     // TODO: hook real main menu world
                     return std::make_unique<TestWorld>();
@@ -25,10 +33,15 @@ namespace Bocchi {
 
     void App::init() {
         const auto& config = Config::getInstance();
+        auto& trace = StartupTrace::getInstance();
+
+        trace.begin("window");
         m_window = std::make_unique<sf::RenderWindow>(sf::VideoMode(config.windowWidth, config.windowHeight), config.windowTitle);
         m_window->setFramerateLimit(60);
+        trace.end("window");
         m_res = std::make_unique<ResourceManager>();
         m_builder = std::make_unique<EntityBuilder>();
+        m_frameArena = std::make_unique<FrameArena>();
         m_worldView = std::make_unique<sf::View>(sf::FloatRect(0, 0, config.windowWidth, config.windowHeight));
         m_uiView = std::make_unique<sf::View>(sf::FloatRect(0, 0, config.windowWidth, config.windowHeight));
         m_worldView->setCenter(config.windowWidth / 2.f, config.windowHeight / 2.f);
@@ -38,6 +51,8 @@ namespace Bocchi {
         m_sharedContext.services.app = this;
         m_sharedContext.services.res = m_res.get();
         m_sharedContext.services.builder = m_builder.get();
+        m_sharedContext.services.frameArena = m_frameArena.get();
+        assert(m_sharedContext.services.frameArena && "render systems require the frame arena");
         m_sharedContext.window.window = m_window.get();
         m_sharedContext.window.worldView = m_worldView.get();
         m_sharedContext.window.uiView = m_uiView.get();
@@ -45,20 +60,28 @@ namespace Bocchi {
         m_sharedContext.window.mapSize = sf::Vector2f(config.mapWidth, config.mapHeight);
         m_sharedContext.window.cameraPos = sf::Vector2f(config.windowWidth / 2.f, config.windowHeight / 2.f);
 
-        m_res->loadAll();
+        // 优先读取构建时生成的打包文件，缺失时回退到逐文件异步解码
+        // 异步加载的 "assets" 阶段由 AssetLoadSystem 在加载完成时结束
+        trace.begin("assets");
+        if (m_res->loadArchive(AssetArchive::DEFAULT_PATH)) {
+            trace.end("assets");
+        } else {
+            m_res->beginAsyncLoad();
+        }
         // 窗口图标
         // sf::Image icon;
         // if (icon.loadFromFile("assets/textures/head_maodie.png")) {
         //     m_window->setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
         // }
 
-        m_currentWorld = createWorld(WorldType::ClassicMode);
+        m_currentWorldType = WorldType::Loading;
+        m_currentWorld = createWorld(m_currentWorldType);
         m_currentWorld->init(m_sharedContext);
 
         m_isRunning = true;
     }
 
-    void App::run() {
+    int App::run() {
         init();
         sf::Clock clock;
         while (m_isRunning && m_window->isOpen()) {
@@ -67,6 +90,12 @@ namespace Bocchi {
             update();
         }
         quit();
+
+        auto& trace = StartupTrace::getInstance();
+        if (trace.reportRequested() || (trace.isReady() && !trace.withinBudget())) {
+            trace.report(std::cout);
+        }
+        return (trace.checkRequested() && !trace.withinBudget()) ? 1 : 0;
     }
 
     void App::update() {
@@ -76,6 +105,7 @@ namespace Bocchi {
         ctx.window.uiView = m_uiView.get();
         ctx.services.res = m_res.get();
         ctx.services.builder = m_builder.get();
+        ctx.services.frameArena = m_frameArena.get();
         ctx.services.app = this;
         ctx.time.dt = m_sharedContext.time.dt;
         ctx.time.frameCount = m_sharedContext.time.frameCount;
@@ -93,6 +123,7 @@ namespace Bocchi {
                 m_uiView->setSize(w, h);
                 m_uiView->setCenter(w / 2.f, h / 2.f);
                 ctx.window.windowSize = sf::Vector2f(w, h);
+                ctx.window.sceneFrozen = false;
             }
         }
 
@@ -104,15 +135,53 @@ namespace Bocchi {
         }
 
         m_window->display();
+        m_res->endFrame();
+        endFrameStats(m_currentWorld->context());
+
+        // 进入游戏世界后的第一帧视为启动完成
+        auto& trace = StartupTrace::getInstance();
+        if (!trace.isReady() && m_currentWorldType == WorldType::ClassicMode) {
+            trace.markReady();
+            if (trace.checkRequested()) m_isRunning = false;
+        }
+    }
+
+    // 帧末：重置帧内存，记录本帧堆分配；开启统计时每秒输出一次均值与峰值
+    void App::endFrameStats(GameContext& ctx) {
+        ctx.stats.arenaBytes = m_frameArena->used();
+        m_frameArena->reset();
+
+        if constexpr (!AllocTracker::enabled) return;
+        AllocTracker::Counters now = AllocTracker::threadCounters();
+        AllocTracker::Counters frame = now - m_frameAllocStart;
+        m_frameAllocStart = now;
+        ctx.stats.heapAllocs = frame.count;
+        ctx.stats.heapBytes = frame.bytes;
+
+        m_reportAllocs += frame.count;
+        m_reportPeakAllocs = std::max(m_reportPeakAllocs, frame.count);
+        if (ctx.time.frameCount % 60 == 0) {
+            std::cout << "[alloc] frame " << ctx.time.frameCount
+                      << ": avg " << m_reportAllocs / 60 << " heap allocs/frame, peak " << m_reportPeakAllocs
+                      << ", arena " << ctx.stats.arenaBytes << "/" << m_frameArena->capacity() << " bytes" << std::endl;
+            m_reportAllocs = 0;
+            m_reportPeakAllocs = 0;
+        }
     }
 
     void App::changeWorld(WorldType type) {
         GameContext nextCtx = m_currentWorld ? m_currentWorld->context() : m_sharedContext;
 
         nextCtx.food.foodSystem = nullptr;
-        if (m_currentWorld) m_currentWorld->quit();
+        nextCtx.window.sceneFrozen = false;
+        if (m_currentWorld) {
+            m_currentWorld->reportAllocations(std::cout);
+            m_currentWorld->quit();
+        }
         
+        m_currentWorldType = type;
         m_currentWorld = createWorld(type);
+        StartupTrace::Scope scope("world_init");
         m_currentWorld->init(nextCtx);
     }
 
@@ -121,7 +190,10 @@ namespace Bocchi {
     }
 
     void App::quit() {
-        if (m_currentWorld) m_currentWorld->quit();
+        if (m_currentWorld) {
+            m_currentWorld->reportAllocations(std::cout);
+            m_currentWorld->quit();
+        }
         if (m_res) m_res->unloadAll();
         if (m_window) m_window->close();
     }
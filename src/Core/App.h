@@ -4,6 +4,8 @@
 #include <vector>
 #include "World.hpp"
 #include "Context.hpp"
+#include "FrameArena.h"
+#include "AllocTracker.h"
 #include "Game/Builders/EntityBuilder.hpp"
 
 namespace Bocchi {
@@ -16,7 +18,7 @@ namespace Bocchi {
         App();
         ~App();
 
-        void run();
+        int run();
         void requestChangeWorld(WorldType type);
 
     private:
@@ -24,9 +26,11 @@ namespace Bocchi {
         void quit();
         void update();
         void changeWorld(WorldType type);
+        void endFrameStats(GameContext& ctx);
 
         bool m_isRunning;
         WorldType m_targetWorld = WorldType::Empty;
+        WorldType m_currentWorldType = WorldType::Empty;
 
         std::unique_ptr<sf::RenderWindow> m_window;
         std::unique_ptr<sf::View> m_worldView;
@@ -34,6 +38,11 @@ namespace Bocchi {
         std::unique_ptr<ResourceManager> m_res;
         std::unique_ptr<World> m_currentWorld;
         std::unique_ptr<EntityBuilder> m_builder;
+        std::unique_ptr<FrameArena> m_frameArena;
+
+        AllocTracker::Counters m_frameAllocStart;
+        uint64_t m_reportAllocs = 0;
+        uint64_t m_reportPeakAllocs = 0;
 
         GameContext m_sharedContext;
     };
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+
+namespace Bocchi {
+
+    // 打包资源文件格式（构建时由 AssetPacker 生成，运行时内存映射读取）
+    //   [ArchiveHeader][ArchiveEntry * entryCount][数据区...]
+    // 贴图数据为 RGBA8 像素，音效数据为 int16 PCM 采样
+    namespace AssetArchive {
+        constexpr char MAGIC[4] = {'B', 'P', 'A', 'K'};
+        constexpr uint32_t VERSION = 1;
+        constexpr uint64_t DATA_ALIGN = 16;
+        constexpr const char* DEFAULT_PATH = "assets/assets.pak";
+
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t reserved;
+        };
+
+        struct Entry {
+            uint32_t id;            // ResID
+            uint32_t kind;          // AssetKind
+            uint32_t width;         // 贴图宽 / 音效声道数
+            uint32_t height;        // 贴图高 / 音效采样率
+            uint64_t offset;        // 相对文件起始
+            uint64_t size;          // 字节数
+        };
+
+        static_assert(sizeof(Header) == 16, "archive header layout");
+        static_assert(sizeof(Entry) == 32, "archive entry layout");
+    }
+}
@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <deque>
+#include <cstdint>
 #include <entt/entt.hpp>
 
 namespace Bocchi {
@@ -14,6 +15,11 @@ namespace Bocchi {
         Position(float x, float y) : val(x, y) {}
     };
 
+    // 蛇头上一帧的位置，碰撞检测按这一帧的移动轨迹做扫掠
+    struct PrevPosition {
+        sf::Vector2f val;
+    };
+
     struct Rotation {
         float angle = 0.0f;
     };
@@ -34,9 +40,9 @@ namespace Bocchi {
         float range = 150.0f;
     };
 
+    // 蛇头按访问频率拆分：SnakeHead 只放每帧移动/转向/碰撞都要读写的标量，
+    // 路径与身体句柄、成长统计、外观各自成组件，遍历时只拉取用到的部分
     struct SnakeHead {
-        SnakeHead() { pathHistory.reserve(2000); }
-
         float targetAngle = 0.0f;
         float turnSpeed = 8.0f; 
         
@@ -44,23 +50,40 @@ namespace Bocchi {
         float spacingFactor = 0.8f;
         float distAccumulator = 0.0f;
 
+        float spawnProtectionTime = 0.0f;
+
+        bool isDead = false;
+    };
+
+    struct SnakePath {
+        SnakePath() { pathHistory.reserve(2000); }
+
         std::vector<sf::Vector2f> pathHistory;
         std::vector<entt::entity> bodyEntities;
+    };
 
+    struct SnakeStats {
         int pendingGrowth = 0;
         int currentLength = 1;
         float energyAccumulator = 0.0f;
         float totalEnergy = 0.0f;
+        int kills = 0;
+    };
 
-        ResID headID;
-        ResID bodyID;
-        ResID foodID;
+    struct SnakeSkin {
+        ResID headID = ResID::NONE;
+        ResID bodyID = ResID::NONE;
+        ResID foodID = ResID::NONE;
+        ResID eatSoundID = ResID::NONE;
 
         sf::Color color;
+    };
 
-        bool isDead = false;
-
-        float spawnProtectionTime;
+    // 蛇皮肤贴图句柄，随实体销毁释放，保证存活蛇的贴图不被淘汰
+    struct SkinHandles {
+        TextureHandle head;
+        TextureHandle body;
+        TextureHandle food;
     };
 
     struct SnakeBody {
@@ -71,6 +94,40 @@ namespace Bocchi {
             : headOwner(head), segmentIndex(index) {}
     };
 
+    // 紧凑身体（Config::packedSnakeBodies）：整条蛇的身体节以 SoA 数组挂在头部实体上，
+    // 下标即节序号，不再为每节创建实体
+    struct SnakeSegments {
+        enum Flag : uint8_t {
+            None = 0,
+            Placed = 1 << 0,    // 已由移动系统沿路径放置过（新生成的节尚在地图外）
+        };
+
+        std::vector<sf::Vector2f> positions;
+        std::vector<float> radii;
+        std::vector<uint8_t> flags;
+
+        size_t size() const { return positions.size(); }
+        bool empty() const { return positions.empty(); }
+
+        void reserve(size_t count) {
+            positions.reserve(count);
+            radii.reserve(count);
+            flags.reserve(count);
+        }
+
+        void push(sf::Vector2f pos, float radius, uint8_t flag = None) {
+            positions.push_back(pos);
+            radii.push_back(radius);
+            flags.push_back(flag);
+        }
+
+        void clear() {
+            positions.clear();
+            radii.clear();
+            flags.clear();
+        }
+    };
+
     // struct FoodData {
     //     ResID resID;
     //     float energy;  
@@ -81,6 +138,8 @@ namespace Bocchi {
 
 
     struct PlayerTag {};
+    struct ParkedSegment {};    // 回收池中闲置的身体节，不属于任何蛇
+    struct RadiusEasing {};     // 半径尚未缓动到当前长度的目标值，成长系统只遍历带此标记的蛇
     struct AiTag{
         int level = 1;
         float stateTimer = 0.f;
@@ -100,12 +159,6 @@ namespace Bocchi {
         sf::Color color = sf::Color::White;
     };
 
-    struct SoundComponent {
-        ResID soundID = ResID::NONE;
-        sf::Sound sound; 
-    };
-
-
     struct Wallet {
         int coins = 0;
     };
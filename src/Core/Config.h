@@ -15,13 +15,39 @@ struct Config {
     float baseRadius = 20.0f;
     float growthScale = 1.2f;
     float maxRadius = 100.0f;
+    float segmentSpacingFactor = 0.8f;
+    int growthTableLength = 1024;   // 成长曲线表覆盖的最大长度
     
     int maxAICount = 15;
+    int collisionParallelMinHeads = 32; // 蛇头数达到此值才分线程做碰撞窄检测，0 为始终串行
+    int collisionWorkers = 0;           // 碰撞检测线程数，0 为按 CPU 核数
+    int expectedSnakeLength = 40;   // 世界初始化时按此预留身体节点容量
+    bool packedSnakeBodies = false; // 身体节存为头部上的连续数组，而非每节一个实体
+
+    // 渲染 LOD 阈值（屏幕像素半径）
+    float lodFlatPixelRadius = 8.0f;
+    float lodTrailPixelRadius = 3.0f;
+    float lodEyePixelRadius = 6.0f;
+    float lodFoodPointPixelRadius = 2.0f;
+    bool ribbonSnakeBodies = false; // 无贴图的蛇身体整条画成三角带，而非逐节画圆
+
+    int maxSoundVoices = 16;
+    float soundHearingRange = 1200.0f;
+    float soundMinAudibleVolume = 2.0f;
 
     int maxTotalFood = 1500;
+    int deathDropCoalesceThreshold = 64;  // 单次死亡掉落的最大食物数，超出则合并相邻节，0 为不合并
     int minFoodPerCell = 1;
     float spawnChance = 0.01f;
     
+    float startupBudgetMs = 3000.0f;
+
+    bool lazyTextures = true;
+    float textureMemoryCapMB = 64.0f;
+
+    // 分配统计：前若干帧视为预热，之后的分配算作稳态分配
+    int allocWarmupFrames = 300;
+
     int windowWidth = 800;
     int windowHeight = 600;
     std::string windowTitle = "Snake";
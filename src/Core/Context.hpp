@@ -1,11 +1,15 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <vector>
+#include <entt/entity/entity.hpp>
+#include "ResourceManager.h"
 
 namespace Bocchi {
     class App;
     class EntityBuilder;
     class ResourceManager;
     class FoodSpawnSystem;
+    class FrameArena;
 
     struct TimeContext {
         float dt = 0.f;
@@ -20,12 +24,14 @@ namespace Bocchi {
         sf::Vector2f mouseWorldPos{};
         sf::Vector2f windowSize{};
         sf::Vector2f mapSize{5000.f, 5000.f};
+        bool sceneFrozen = false;   // 暂停时场景已缓存，场景渲染系统跳过绘制
     };
 
     struct ServiceContext {
         App* app = nullptr;
         ResourceManager* res = nullptr;
         EntityBuilder* builder = nullptr;
+        FrameArena* frameArena = nullptr;   // 单帧临时内存，帧末由 App 重置；App 保证非空，系统直接使用
     };
 
     struct InputContext {
@@ -44,6 +50,45 @@ namespace Bocchi {
         FoodSpawnSystem* foodSystem = nullptr;
     };
 
+    enum class SoundPriority {
+        Ambient = 0,
+        Player = 1,
+    };
+
+    struct SoundEvent {
+        ResID soundID = ResID::NONE;
+        sf::Vector2f pos;
+        float volume = 100.f;
+        SoundPriority priority = SoundPriority::Ambient;
+    };
+
+    // 蛇攒够能量需要长身体，由 SnakeGrowthSystem 消费
+    struct GrowthEvent {
+        entt::entity snake = entt::null;
+    };
+
+    // 蛇头撞死的记录，killer 为空表示撞墙；由 DeathSystem 消费
+    struct CollisionEvent {
+        entt::entity victim = entt::null;
+        entt::entity killer = entt::null;
+        sf::Vector2f pos;
+        uint32_t frame = 0;
+    };
+
+    // 单帧事件队列，由生产系统写入、消费系统清空
+    struct EventContext {
+        std::vector<SoundEvent> sounds;
+        std::vector<GrowthEvent> growth;
+        std::vector<CollisionEvent> collisions;
+    };
+
+    // 上一帧的内存统计（堆分配计数需开启 BOCCHI_ALLOC_TRACKING）
+    struct FrameStats {
+        uint64_t heapAllocs = 0;
+        uint64_t heapBytes = 0;
+        size_t arenaBytes = 0;
+    };
+
     struct GameContext {
         TimeContext time;
         WindowContext window;
@@ -51,5 +96,7 @@ namespace Bocchi {
         InputContext input;
         GameStateContext state;
         FoodServices food;
+        EventContext events;
+        FrameStats stats;
     };
 } // namespace Bocchi
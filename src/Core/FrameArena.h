@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Bocchi {
+
+    // 单帧线性分配器：系统的临时缓冲从这里切出，App 在每帧末尾统一 reset
+    // 放不下时临时向堆申请溢出块，reset 时把主块扩到本帧峰值，稳定后每帧零堆分配
+    class FrameArena {
+    public:
+        explicit FrameArena(size_t capacity = 1 << 20)
+            : m_block(std::make_unique<std::byte[]>(capacity)), m_capacity(capacity) {}
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+            size_t offset = (m_offset + align - 1) & ~(align - 1);
+            if (offset + bytes <= m_capacity) {
+                m_offset = offset + bytes;
+                return m_block.get() + offset;
+            }
+            m_overflowBytes += bytes + align;
+            m_overflow.push_back(std::make_unique<std::byte[]>(bytes + align));
+            void* p = m_overflow.back().get();
+            size_t space = bytes + align;
+            return std::align(align, bytes, p, space);
+        }
+
+        void reset() {
+            size_t used = m_offset + m_overflowBytes;
+            if (used > m_peak) m_peak = used;
+            if (!m_overflow.empty()) {
+                m_overflow.clear();
+                m_capacity = m_peak + m_peak / 2;
+                m_block = std::make_unique<std::byte[]>(m_capacity);
+            }
+            m_offset = 0;
+            m_overflowBytes = 0;
+        }
+
+        size_t used() const { return m_offset + m_overflowBytes; }
+        size_t capacity() const { return m_capacity; }
+        size_t peak() const { return m_peak; }
+
+    private:
+        std::unique_ptr<std::byte[]> m_block;
+        std::vector<std::unique_ptr<std::byte[]>> m_overflow;
+        size_t m_capacity = 0;
+        size_t m_offset = 0;
+        size_t m_overflowBytes = 0;
+        size_t m_peak = 0;
+    };
+
+    // STL 分配器：释放为空操作，内存随 FrameArena::reset 整体回收
+    template <typename T>
+    class FrameAllocator {
+    public:
+        using value_type = T;
+
+        explicit FrameAllocator(FrameArena& arena) : m_arena(&arena) {}
+        template <typename U>
+        FrameAllocator(const FrameAllocator<U>& other) : m_arena(other.arena()) {}
+
+        T* allocate(size_t n) { return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) {}
+
+        FrameArena* arena() const { return m_arena; }
+
+        template <typename U>
+        bool operator==(const FrameAllocator<U>& other) const { return m_arena == other.arena(); }
+        template <typename U>
+        bool operator!=(const FrameAllocator<U>& other) const { return m_arena != other.arena(); }
+
+    private:
+        FrameArena* m_arena;
+    };
+
+    // 只在当前帧内使用，不可跨帧保存
+    template <typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <entt/entt.hpp>
+#include "Core/Config.h"
+
+namespace Bocchi {
+
+    // 某一长度下蛇的目标属性
+    struct GrowthStage {
+        float radius;
+        float turnSpeed;
+        float magnetRange;
+        float spacingFactor;
+        float growthThreshold;   // 再长一节所需能量
+    };
+
+    // 成长曲线：启动时按 Config 把各长度的属性算成表，运行时只在长度变化时查表
+    // 超过表长的蛇沿用最后一档
+    class GrowthCurve {
+    public:
+        explicit GrowthCurve(const Config& config) {
+            int count = std::max(config.growthTableLength, config.defaultSnakeLength + 1);
+            m_stages.resize(static_cast<size_t>(count));
+
+            for (int length = 0; length < count; ++length) {
+                GrowthStage& stage = m_stages[length];
+                float grown = static_cast<float>(std::max(0, length - config.defaultSnakeLength));
+                stage.radius = std::min(
+                    config.defaultSnakeRadius + config.defaultSnakeRadius * std::sqrt(grown) * 0.3f,
+                    config.maxRadius
+                );
+
+                float deltaR = std::max(0.f, stage.radius - config.defaultSnakeRadius);
+                stage.turnSpeed = 8.f * (0.4f + 0.6f * std::exp(-0.02f * deltaR));
+                stage.magnetRange = stage.radius * 2.5f;
+                stage.spacingFactor = config.segmentSpacingFactor;
+                stage.growthThreshold = 10.f + length * 0.5f;
+            }
+        }
+
+        const GrowthStage& at(int length) const {
+            size_t index = static_cast<size_t>(std::clamp(length, 0, static_cast<int>(m_stages.size()) - 1));
+            return m_stages[index];
+        }
+
+        size_t size() const { return m_stages.size(); }
+
+    private:
+        std::vector<GrowthStage> m_stages;
+    };
+
+    // 取当前世界的成长曲线，没有则按 Config 构建
+    inline const GrowthCurve& growthCurve(entt::registry& reg) {
+        if (auto* curve = reg.ctx().find<GrowthCurve>()) return *curve;
+        return reg.ctx().emplace<GrowthCurve>(Config::getInstance());
+    }
+}
@@ -1,6 +1,11 @@
 #include "ResourceManager.h"
+#include "AssetArchive.h"
+#include "MappedFile.h"
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
 
 namespace Bocchi {
 
@@ -12,29 +17,362 @@ namespace Bocchi {
         // } else {
         //     std::cout << "Error: 'assets' folder NOT found in current directory." << std::endl;
         // }
-        add<sf::Texture>(ResID::head_maodie, "assets/textures/head_maodie.png");
-        add<sf::Texture>(ResID::head_maodie_o, "assets/textures/head_maodie_o.png");
-        add<sf::Texture>(ResID::head_shantianliang, "assets/textures/head_shantianliang.png");
-        add<sf::Texture>(ResID::head_maodie_h, "assets/textures/head_maodie_h.png");
-        add<sf::Texture>(ResID::head_xiduoyudai, "assets/textures/head_xiduoyudai.jpg");
-        
+        for (const auto& entry : ASSET_MANIFEST) {
+            if (entry.kind == AssetKind::Texture) {
+                if (!m_lazyTextures) uploadTexture(entry.id, decodeTexture(entry.id));
+            } else {
+                add<sf::SoundBuffer>(entry.id, entry.path);
+            }
+        }
+        validate();
+    }
+
+    bool ResourceManager::loadArchive(const std::string& path) {
+        // 映射在整个生命周期内保持打开，按需加载的贴图直接从中读取
+        MappedFile& file = m_archive;
+        if (!file.open(path)) return false;
+
+        const unsigned char* base = file.data();
+        if (file.size() < sizeof(AssetArchive::Header)) return false;
+        const auto* header = reinterpret_cast<const AssetArchive::Header*>(base);
+        if (std::memcmp(header->magic, AssetArchive::MAGIC, 4) != 0 || header->version != AssetArchive::VERSION) {
+            std::cerr << "Asset archive has wrong format: " << path << std::endl;
+            file.close();
+            return false;
+        }
+        size_t indexEnd = sizeof(AssetArchive::Header) + sizeof(AssetArchive::Entry) * static_cast<size_t>(header->entryCount);
+        if (file.size() < indexEnd) {
+            file.close();
+            return false;
+        }
+
+        const auto* entries = reinterpret_cast<const AssetArchive::Entry*>(base + sizeof(AssetArchive::Header));
+        for (uint32_t i = 0; i < header->entryCount; ++i) {
+            const auto& e = entries[i];
+            if (e.id >= RES_COUNT || e.offset + e.size > file.size()) {
+                std::cerr << "Asset archive entry out of range: " << e.id << std::endl;
+                continue;
+            }
+            ResID id = static_cast<ResID>(e.id);
+            const unsigned char* bytes = base + e.offset;
+
+            if (static_cast<AssetKind>(e.kind) == AssetKind::Texture) {
+                if (e.size != static_cast<uint64_t>(e.width) * e.height * 4) continue;
+                m_archiveIndex[toIndex(id)] = &e;
+                if (m_lazyTextures) continue;
+                uploadTexture(id, decodeTexture(id));
+            } else {
+                auto sb = std::make_unique<sf::SoundBuffer>();
+                const auto* samples = reinterpret_cast<const sf::Int16*>(bytes);
+                if (sb->loadFromSamples(samples, e.size / sizeof(sf::Int16), e.width, e.height)) {
+                    m_soundBuffers[toIndex(id)] = std::move(sb);
+                }
+            }
+        }
+        validate();
+        return true;
+    }
+
+    ResourceManager::~ResourceManager() {
+        joinLoaders();
+        waitPrefetches();
+    }
 
-        add<sf::Texture>(ResID::body_maodie, "assets/textures/body_maodie.png");
-        add<sf::Texture>(ResID::body_shantianliang, "assets/textures/body_shantianliang.png");
+    void ResourceManager::beginAsyncLoad() {
+        joinLoaders();
+        m_ready.clear();
+        m_nextAsset = 0;
+        m_decodedCount = 0;
+        m_uploadedCount = 0;
+
+        m_asyncQueue.clear();
+        for (size_t i = 0; i < std::size(ASSET_MANIFEST); ++i) {
+            if (m_lazyTextures && ASSET_MANIFEST[i].kind == AssetKind::Texture) continue;
+            m_asyncQueue.push_back(i);
+        }
+        m_totalAssets = m_asyncQueue.size();
+        if (m_totalAssets == 0) return;
+
+        unsigned int workers = std::max(1u, std::thread::hardware_concurrency());
+        workers = std::min<unsigned int>(workers, static_cast<unsigned int>(m_totalAssets));
+        for (unsigned int i = 0; i < workers; ++i) {
+            m_loaders.emplace_back(&ResourceManager::decodeWorker, this);
+        }
+    }
+
+    void ResourceManager::decodeWorker() {
+        while (true) {
+            size_t index = m_nextAsset.fetch_add(1);
+            if (index >= m_totalAssets) return;
+            const auto& entry = ASSET_MANIFEST[m_asyncQueue[index]];
+
+            DecodedAsset asset;
+            asset.id = entry.id;
+            asset.kind = entry.kind;
+            if (entry.kind == AssetKind::Texture) {
+                asset.ok = asset.image.loadFromFile(entry.path);
+                if (asset.ok) fitImage(asset.image, entry.maxDrawSize);
+            } else {
+                sf::InputSoundFile file;
+                if (file.openFromFile(entry.path)) {
+                    asset.samples.resize(static_cast<size_t>(file.getSampleCount()));
+                    asset.samples.resize(static_cast<size_t>(file.read(asset.samples.data(), asset.samples.size())));
+                    asset.channelCount = file.getChannelCount();
+                    asset.sampleRate = file.getSampleRate();
+                    asset.ok = !asset.samples.empty();
+                }
+            }
+            if (!asset.ok) std::cerr << "Failed to decode asset: " << entry.path << std::endl;
+
+            {
+                std::lock_guard<std::mutex> lock(m_readyMutex);
+                m_ready.push_back(std::move(asset));
+            }
+            m_decodedCount++;
+        }
+    }
 
-        add<sf::Texture>(ResID::food_huotuichang, "assets/textures/food_huotuichang.png");
-        add<sf::Texture>(ResID::food_pingguohe, "assets/textures/food_pingguohe.png");
-        add<sf::Texture>(ResID::food_bocchi, "assets/textures/food_bocchi.png");
+    bool ResourceManager::pollAsyncLoad() {
+        std::vector<DecodedAsset> batch;
+        {
+            std::lock_guard<std::mutex> lock(m_readyMutex);
+            batch.swap(m_ready);
+        }
+
+        // GPU 上传必须在持有 GL 上下文的渲染线程完成
+        for (auto& asset : batch) {
+            if (asset.ok) {
+                if (asset.kind == AssetKind::Texture) {
+                    uploadTexture(asset.id, asset);
+                } else {
+                    auto sb = std::make_unique<sf::SoundBuffer>();
+                    if (sb->loadFromSamples(asset.samples.data(), asset.samples.size(), asset.channelCount, asset.sampleRate)) {
+                        m_soundBuffers[toIndex(asset.id)] = std::move(sb);
+                    }
+                }
+            }
+            m_uploadedCount++;
+        }
+
+        if (!batch.empty() && isAsyncLoadDone()) {
+            joinLoaders();
+            validate();
+        }
+        return isAsyncLoadDone();
+    }
+
+    size_t ResourceManager::validate() {
+        m_missing.clear();
+        for (const auto& entry : ASSET_MANIFEST) {
+            bool present = (entry.kind == AssetKind::Texture)
+                ? (has<sf::Texture>(entry.id) || (m_lazyTextures && hasTextureSource(entry.id)))
+                : has<sf::SoundBuffer>(entry.id);
+            if (present) continue;
+
+            std::cerr << "Missing asset: " << entry.path << std::endl;
+            m_missing.push_back(entry.id);
+            if (entry.kind == AssetKind::Texture) {
+                // 品红占位贴图，缺图一眼可见
+                sf::Image placeholder;
+                placeholder.create(2, 2, sf::Color::Magenta);
+                auto tex = std::make_unique<sf::Texture>();
+                tex->loadFromImage(placeholder);
+                m_textures[toIndex(entry.id)] = std::move(tex);
+                m_residency[toIndex(entry.id)].pinned = true;
+            } else {
+                m_soundBuffers[toIndex(entry.id)] = std::make_unique<sf::SoundBuffer>();
+            }
+        }
+        return m_missing.size();
+    }
+
+    float ResourceManager::loadProgress() const {
+        if (m_totalAssets == 0) return 1.f;
+        // 解码和上传各占一半
+        return (static_cast<float>(m_decodedCount) + static_cast<float>(m_uploadedCount)) / (2.f * m_totalAssets);
+    }
+
+    void ResourceManager::joinLoaders() {
+        for (auto& t : m_loaders) {
+            if (t.joinable()) t.join();
+        }
+        m_loaders.clear();
+    }
+
+    TextureHandle ResourceManager::acquireTexture(ResID id) {
+        if (id == ResID::NONE) return {};
+        get<sf::Texture>(id);
+        return TextureHandle(this, id);
+    }
+
+    void ResourceManager::retainTexture(ResID id) {
+        m_residency[toIndex(id)].refCount++;
+    }
+
+    void ResourceManager::releaseTexture(ResID id) {
+        auto& r = m_residency[toIndex(id)];
+        if (r.refCount > 0) r.refCount--;
+    }
+
+    void ResourceManager::prefetchTexture(ResID id) {
+        if (id == ResID::NONE) return;
+        size_t i = toIndex(id);
+        auto& r = m_residency[i];
+        if (m_textures[i] || r.prefetch.valid()) return;
+        r.prefetch = std::async(std::launch::async, [this, id]() { return decodeTexture(id); });
+    }
+
+    void ResourceManager::prefetchWithinBudget() {
+        if (!m_lazyTextures) return;
+        const size_t cap = static_cast<size_t>(Config::getInstance().textureMemoryCapMB * 1024.f * 1024.f);
+        size_t bytes = residentTextureBytes();
+        for (const auto& entry : ASSET_MANIFEST) {
+            if (entry.kind != AssetKind::Texture || entry.maxDrawSize == 0) continue;
+            if (m_textures[toIndex(entry.id)]) continue;
+            // 按最大绘制尺寸的正方形估算，实际贴图不会更大
+            size_t base = static_cast<size_t>(entry.maxDrawSize) * entry.maxDrawSize * 4;
+            size_t estimate = base + base / 3;
+            if (bytes + estimate > cap) continue;
+            bytes += estimate;
+            prefetchTexture(entry.id);
+        }
+    }
+
+    bool ResourceManager::prefetchPending() const {
+        for (const auto& r : m_residency) {
+            if (r.prefetch.valid()) return true;
+        }
+        return false;
+    }
+
+    sf::Texture& ResourceManager::ensureTexture(ResID id) {
+        size_t i = toIndex(id);
+        auto& r = m_residency[i];
+        DecodedAsset asset = r.prefetch.valid() ? r.prefetch.get() : decodeTexture(id);
+        uploadTexture(id, asset);
+
+        if (!m_textures[i]) {
+            std::cerr << "Missing texture at runtime: " << static_cast<int>(id) << std::endl;
+            sf::Image placeholder;
+            placeholder.create(2, 2, sf::Color::Magenta);
+            auto tex = std::make_unique<sf::Texture>();
+            tex->loadFromImage(placeholder);
+            m_textures[i] = std::move(tex);
+            r.pinned = true;
+        }
+        return *m_textures[i];
+    }
+
+    bool ResourceManager::hasTextureSource(ResID id) const {
+        if (m_archiveIndex[toIndex(id)]) return true;
+        for (const auto& entry : ASSET_MANIFEST) {
+            if (entry.id == id) return std::filesystem::exists(entry.path);
+        }
+        return false;
+    }
+
+    // 可在后台线程调用：只读资源包映射或源文件，不触碰 GL
+    ResourceManager::DecodedAsset ResourceManager::decodeTexture(ResID id) const {
+        DecodedAsset asset;
+        asset.id = id;
+        asset.kind = AssetKind::Texture;
+
+        if (const auto* e = m_archiveIndex[toIndex(id)]) {
+            asset.image.create(e->width, e->height, m_archive.data() + e->offset);
+            asset.ok = true;
+        } else {
+            for (const auto& entry : ASSET_MANIFEST) {
+                if (entry.id == id) {
+                    asset.ok = asset.image.loadFromFile(entry.path);
+                    break;
+                }
+            }
+        }
+        // 打包时已缩好的贴图这里不会再处理；旧资源包或源文件在解码线程上缩小
+        if (asset.ok) fitImage(asset.image, maxDrawSize(id));
+        return asset;
+    }
+
+    unsigned int ResourceManager::maxDrawSize(ResID id) {
+        for (const auto& entry : ASSET_MANIFEST) {
+            if (entry.id == id) return entry.maxDrawSize;
+        }
+        return 0;
+    }
+
+    void ResourceManager::uploadTexture(ResID id, const DecodedAsset& asset) {
+        if (!asset.ok) return;
+        auto tex = std::make_unique<sf::Texture>();
+        if (tex->loadFromImage(asset.image)) {
+            // 蛇和食物通常远小于贴图尺寸绘制，mipmap 让缩小采样取对应层级
+            tex->setSmooth(true);
+            tex->generateMipmap();
+            m_textures[toIndex(id)] = std::move(tex);
+            m_residency[toIndex(id)].pinned = false;
+        }
+    }
+
+    void ResourceManager::endFrame() {
+        for (size_t i = 0; i < RES_COUNT; ++i) {
+            auto& r = m_residency[i];
+            if (r.prefetch.valid() && r.prefetch.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                uploadTexture(static_cast<ResID>(i), r.prefetch.get());
+                r.lastUse = m_frame;
+            }
+        }
+        evictTextures();
+        m_frame++;
+    }
+
+    size_t ResourceManager::residentTextureBytes() const {
+        size_t bytes = 0;
+        for (const auto& tex : m_textures) {
+            if (tex) bytes += textureBytes(*tex);
+        }
+        return bytes;
+    }
+
+    // 显存估算：RGBA8 底层 + 完整 mipmap 链约多 1/3
+    size_t ResourceManager::textureBytes(const sf::Texture& tex) {
+        sf::Vector2u size = tex.getSize();
+        size_t base = static_cast<size_t>(size.x) * size.y * 4;
+        return base + base / 3;
+    }
+
+    // 超出上限时淘汰最久未用、未被句柄持有、且本帧未使用的贴图
+    void ResourceManager::evictTextures() {
+        const size_t cap = static_cast<size_t>(Config::getInstance().textureMemoryCapMB * 1024.f * 1024.f);
+        size_t bytes = residentTextureBytes();
+        while (bytes > cap) {
+            size_t victim = RES_COUNT;
+            for (size_t i = 0; i < RES_COUNT; ++i) {
+                const auto& r = m_residency[i];
+                if (!m_textures[i] || r.pinned || r.refCount > 0 || r.lastUse >= m_frame) continue;
+                if (victim == RES_COUNT || r.lastUse < m_residency[victim].lastUse) victim = i;
+            }
+            if (victim == RES_COUNT) return;
+            bytes -= textureBytes(*m_textures[victim]);
+            m_textures[victim].reset();
+        }
+    }
 
-        add<sf::SoundBuffer>(ResID::eat_sound_maodie, "assets/sounds/eat_sound_maodie.mp3");
-        add<sf::SoundBuffer>(ResID::eat_sound_maodie_h, "assets/sounds/eat_sound_maodie_h.wav");
+    void ResourceManager::waitPrefetches() {
+        for (auto& r : m_residency) {
+            if (r.prefetch.valid()) r.prefetch.wait();
+        }
     }
 
     void ResourceManager::unloadAll(){
+        joinLoaders();
+        waitPrefetches();
         // 清理
-        m_textures.clear();
-        m_fonts.clear();
-        m_soundBuffers.clear();
+        for (auto& tex : m_textures) tex.reset();
+        for (auto& font : m_fonts) font.reset();
+        for (auto& sb : m_soundBuffers) sb.reset();
+        for (auto& r : m_residency) r = TextureResidency{};
+        m_archiveIndex.fill(nullptr);
+        m_archive.close();
+        m_missing.clear();
     }
  
 }
\ No newline at end of file
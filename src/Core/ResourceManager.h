@@ -1,10 +1,19 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
-#include <unordered_map>
+#include <array>
 #include <memory>
 #include <string>
 #include <stdexcept>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include "AssetArchive.h"
+#include "MappedFile.h"
+#include "Config.h"
+#include "TextureFit.h"
 
 namespace Bocchi {
 
@@ -25,13 +34,82 @@ namespace Bocchi {
 
         eat_sound_maodie,
         eat_sound_maodie_h,
- 
+
+        COUNT
+    };
+
+    constexpr size_t RES_COUNT = static_cast<size_t>(ResID::COUNT);
+
+    // 以 ResID 直接下标的资源表
+    template <typename T>
+    using ResourceTable = std::array<std::unique_ptr<T>, RES_COUNT>;
+
+    enum class AssetKind {
+        Texture,
+        SoundBuffer,
+    };
+
+    struct AssetEntry {
+        ResID id;
+        AssetKind kind;
+        const char* path;
+        unsigned int maxDrawSize = 0;   // 贴图在屏幕上的最大绘制边长（像素），加载时缩到此尺寸，0 为不限
+    };
+
+    // 最大绘制尺寸：镜头缩放 >= 1，世界尺寸即屏幕像素上限
+    // 蛇头/身体按 radius * 2 绘制，半径上限 Config::maxRadius (100)
+    // 掉落食物半径为蛇半径 * 0.8，合并掉落再放大至多 1.5 倍（FoodSpawnSystem::spawnFoodBatch），贴图按 radius * 3.5 绘制
+    inline constexpr unsigned int SNAKE_TEXTURE_MAX = 200;
+    inline constexpr unsigned int FOOD_TEXTURE_MAX = 420;
+
+    // 资源清单：同步加载、异步加载共用
+    inline constexpr AssetEntry ASSET_MANIFEST[] = {
+        {ResID::head_maodie,        AssetKind::Texture, "assets/textures/head_maodie.png", SNAKE_TEXTURE_MAX},
+        {ResID::head_maodie_o,      AssetKind::Texture, "assets/textures/head_maodie_o.png", SNAKE_TEXTURE_MAX},
+        {ResID::head_shantianliang, AssetKind::Texture, "assets/textures/head_shantianliang.png", SNAKE_TEXTURE_MAX},
+        {ResID::head_maodie_h,      AssetKind::Texture, "assets/textures/head_maodie_h.png", SNAKE_TEXTURE_MAX},
+        {ResID::head_xiduoyudai,    AssetKind::Texture, "assets/textures/head_xiduoyudai.jpg", SNAKE_TEXTURE_MAX},
+
+        {ResID::body_maodie,        AssetKind::Texture, "assets/textures/body_maodie.png", SNAKE_TEXTURE_MAX},
+        {ResID::body_shantianliang, AssetKind::Texture, "assets/textures/body_shantianliang.png", SNAKE_TEXTURE_MAX},
+
+        {ResID::food_huotuichang,   AssetKind::Texture, "assets/textures/food_huotuichang.png", FOOD_TEXTURE_MAX},
+        {ResID::food_pingguohe,     AssetKind::Texture, "assets/textures/food_pingguohe.png", FOOD_TEXTURE_MAX},
+        {ResID::food_bocchi,        AssetKind::Texture, "assets/textures/food_bocchi.png", FOOD_TEXTURE_MAX},
+
+        {ResID::eat_sound_maodie,   AssetKind::SoundBuffer, "assets/sounds/eat_sound_maodie.mp3"},
+        {ResID::eat_sound_maodie_h, AssetKind::SoundBuffer, "assets/sounds/eat_sound_maodie_h.wav"},
+    };
+
+    class ResourceManager;
+
+    // 贴图引用计数句柄：持有期间贴图常驻，不会被 LRU 淘汰
+    class TextureHandle {
+    public:
+        TextureHandle() = default;
+        TextureHandle(ResourceManager* mgr, ResID id);
+        TextureHandle(const TextureHandle& other) : TextureHandle(other.m_mgr, other.m_id) {}
+        TextureHandle(TextureHandle&& other) noexcept : m_mgr(other.m_mgr), m_id(other.m_id) { other.m_mgr = nullptr; }
+        TextureHandle& operator=(TextureHandle other) noexcept {
+            std::swap(m_mgr, other.m_mgr);
+            std::swap(m_id, other.m_id);
+            return *this;
+        }
+        ~TextureHandle();
+
+        ResID id() const { return m_id; }
+        explicit operator bool() const { return m_mgr != nullptr; }
+        sf::Texture& get() const;
+
+    private:
+        ResourceManager* m_mgr = nullptr;
+        ResID m_id = ResID::NONE;
     };
 
     class ResourceManager {
     public:
         ResourceManager() = default;
-        
+        ~ResourceManager();
 
         ResourceManager(const ResourceManager&) = delete;
         ResourceManager& operator=(const ResourceManager&) = delete;
@@ -39,6 +117,15 @@ namespace Bocchi {
         void loadAll();
         void unloadAll();
 
+        // 从打包文件加载（内存映射，像素/采样已预解码），文件不存在或格式不符返回 false
+        bool loadArchive(const std::string& path);
+
+        // 异步加载：后台线程解码到内存，渲染线程 pollAsyncLoad 时上传
+        void beginAsyncLoad();
+        bool pollAsyncLoad();
+        bool isAsyncLoadDone() const { return m_uploadedCount == m_totalAssets; }
+        float loadProgress() const;
+
 
         template <typename T>
         void add(ResID id, const std::string& path);
@@ -46,51 +133,137 @@ namespace Bocchi {
         template <typename T>
         T& get(ResID id);
 
+        template <typename T>
+        bool has(ResID id) const;
+
+        // 贴图上传时按清单的 maxDrawSize 缩小并生成 mipmap，缩小绘制时由 GPU 选用合适层级
+        // 贴图按需常驻：首次 get/acquire 时加载，prefetch 在后台预解码，
+        // endFrame 上传预解码结果并在超出 Config::textureMemoryCapMB 时按 LRU 淘汰未被持有的贴图
+        TextureHandle acquireTexture(ResID id);
+        void prefetchTexture(ResID id);
+        // 加载界面预热：按清单顺序预取估算后仍在显存上限内的贴图，避免开局在渲染线程同步解码
+        void prefetchWithinBudget();
+        bool prefetchPending() const;
+        void endFrame();
+        size_t residentTextureBytes() const;
+
+        // 对照清单检查缺失资源：记录、报错并以占位资源填充，避免渲染中途取到空槽
+        size_t validate();
+        const std::vector<ResID>& missing() const { return m_missing; }
+
     private:
-        std::unordered_map<ResID, std::unique_ptr<sf::Texture>>     m_textures;
-        std::unordered_map<ResID, std::unique_ptr<sf::Font>>        m_fonts;
-        std::unordered_map<ResID, std::unique_ptr<sf::SoundBuffer>> m_soundBuffers;
+        struct DecodedAsset {
+            ResID id = ResID::NONE;
+            AssetKind kind = AssetKind::Texture;
+            bool ok = false;
+            sf::Image image;
+            std::vector<sf::Int16> samples;
+            unsigned int channelCount = 0;
+            unsigned int sampleRate = 0;
+        };
+
+        struct TextureResidency {
+            unsigned int refCount = 0;
+            uint64_t lastUse = 0;
+            bool pinned = false;        // 占位贴图，无源可重新加载
+            std::future<DecodedAsset> prefetch;
+        };
+
+        friend class TextureHandle;
+
+        static size_t toIndex(ResID id) { return static_cast<size_t>(id); }
+
+        void retainTexture(ResID id);
+        void releaseTexture(ResID id);
+        sf::Texture& ensureTexture(ResID id);
+        bool hasTextureSource(ResID id) const;
+        DecodedAsset decodeTexture(ResID id) const;
+        static unsigned int maxDrawSize(ResID id);
+        static size_t textureBytes(const sf::Texture& tex);
+        void uploadTexture(ResID id, const DecodedAsset& asset);
+        void evictTextures();
+        void waitPrefetches();
+
+        template <typename T>
+        ResourceTable<T>& table();
+
+        template <typename T>
+        const ResourceTable<T>& table() const { return const_cast<ResourceManager*>(this)->table<T>(); }
+
+        void decodeWorker();
+        void joinLoaders();
+
+        std::vector<size_t> m_asyncQueue;
+        std::vector<std::thread> m_loaders;
+        std::mutex m_readyMutex;
+        std::vector<DecodedAsset> m_ready;
+        std::atomic<size_t> m_nextAsset{0};
+        std::atomic<size_t> m_decodedCount{0};
+        size_t m_uploadedCount = 0;
+        size_t m_totalAssets = 0;
+
+        ResourceTable<sf::Texture>     m_textures;
+        ResourceTable<sf::Font>        m_fonts;
+        ResourceTable<sf::SoundBuffer> m_soundBuffers;
+        std::vector<ResID> m_missing;
+
+        bool m_lazyTextures = Config::getInstance().lazyTextures;
+        uint64_t m_frame = 1;
+        std::array<TextureResidency, RES_COUNT> m_residency;
+        MappedFile m_archive;
+        std::array<const AssetArchive::Entry*, RES_COUNT> m_archiveIndex{};
     };
 
-    // 图像特化
+    // 各资源类型对应的表
     template <>
-    inline void ResourceManager::add<sf::Texture>(ResID id, const std::string& path) {
-        auto tex = std::make_unique<sf::Texture>();
-        if (tex->loadFromFile(path)) {
-            m_textures[id] = std::move(tex);
-        }
-    }
+    inline ResourceTable<sf::Texture>& ResourceManager::table<sf::Texture>() { return m_textures; }
 
     template <>
-    inline sf::Texture& ResourceManager::get<sf::Texture>(ResID id) {
-        return *m_textures.at(id);
-    }
+    inline ResourceTable<sf::Font>& ResourceManager::table<sf::Font>() { return m_fonts; }
 
-    // 字体特化
     template <>
-    inline void ResourceManager::add<sf::Font>(ResID id, const std::string& path) {
-        auto font = std::make_unique<sf::Font>();
-        if (font->loadFromFile(path)) {
-            m_fonts[id] = std::move(font);
+    inline ResourceTable<sf::SoundBuffer>& ResourceManager::table<sf::SoundBuffer>() { return m_soundBuffers; }
+
+    template <typename T>
+    inline void ResourceManager::add(ResID id, const std::string& path) {
+        auto res = std::make_unique<T>();
+        if (res->loadFromFile(path)) {
+            table<T>()[toIndex(id)] = std::move(res);
         }
     }
 
-    template <>
-    inline sf::Font& ResourceManager::get<sf::Font>(ResID id) {
-        return *m_fonts.at(id);
+    template <typename T>
+    inline T& ResourceManager::get(ResID id) {
+        auto& slot = table<T>()[toIndex(id)];
+        // 与原先 map::at 一致：缺失资源抛异常，而不是在 release 构建里解引用空指针
+        if (!slot) throw std::out_of_range("resource not loaded: " + std::to_string(static_cast<int>(id)));
+        return *slot;
     }
 
-    // 音效特化
-    template <>
-    inline void ResourceManager::add<sf::SoundBuffer>(ResID id, const std::string& path) {
-        auto sb = std::make_unique<sf::SoundBuffer>();
-        if (sb->loadFromFile(path)) {
-            m_soundBuffers[id] = std::move(sb);
-        }
+    template <typename T>
+    inline bool ResourceManager::has(ResID id) const {
+        return table<T>()[toIndex(id)] != nullptr;
     }
 
+    // 贴图：记录最近使用帧，未常驻时当场加载
     template <>
-    inline sf::SoundBuffer& ResourceManager::get<sf::SoundBuffer>(ResID id) {
-        return *m_soundBuffers.at(id);
+    inline sf::Texture& ResourceManager::get<sf::Texture>(ResID id) {
+        size_t i = toIndex(id);
+        m_residency[i].lastUse = m_frame;
+        if (!m_textures[i]) return ensureTexture(id);
+        return *m_textures[i];
+    }
+
+    inline TextureHandle::TextureHandle(ResourceManager* mgr, ResID id) : m_mgr(mgr), m_id(id) {
+        if (m_mgr && m_id != ResID::NONE) m_mgr->retainTexture(m_id);
+        else m_mgr = nullptr;
+    }
+
+    inline TextureHandle::~TextureHandle() {
+        if (m_mgr) m_mgr->releaseTexture(m_id);
+    }
+
+    inline sf::Texture& TextureHandle::get() const {
+        return m_mgr->get<sf::Texture>(m_id);
     }
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "StartupTrace.h"
+#include "Config.h"
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <ostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace Bocchi {
+
+    StartupTrace::StartupTrace() : m_origin(std::chrono::steady_clock::now()) {}
+
+    void StartupTrace::parseArgs(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--startup-report") == 0) m_reportOnExit = true;
+            if (std::strcmp(argv[i], "--startup-check") == 0) m_checkMode = m_reportOnExit = true;
+        }
+    }
+
+    double StartupTrace::wallNow() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_origin).count();
+    }
+
+    double StartupTrace::cpuNow() {
+#ifdef _WIN32
+        // MSVC 的 clock() 是墙钟时间，改用进程用户态+内核态时间
+        FILETIME creation, exitTime, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) return 0.0;
+        auto toMs = [](const FILETIME& ft) {
+            ULARGE_INTEGER v;
+            v.LowPart = ft.dwLowDateTime;
+            v.HighPart = ft.dwHighDateTime;
+            return static_cast<double>(v.QuadPart) / 10000.0;
+        };
+        return toMs(kernel) + toMs(user);
+#else
+        return static_cast<double>(std::clock()) * 1000.0 / CLOCKS_PER_SEC;
+#endif
+    }
+
+    void StartupTrace::begin(const std::string& name) {
+        if (m_ready) return;
+        Phase phase;
+        phase.name = name;
+        phase.wallStart = wallNow();
+        phase.cpuStart = cpuNow();
+        m_phases.push_back(std::move(phase));
+    }
+
+    void StartupTrace::end(const std::string& name) {
+        for (auto it = m_phases.rbegin(); it != m_phases.rend(); ++it) {
+            if (it->open && it->name == name) {
+                it->wallMs = wallNow() - it->wallStart;
+                it->cpuMs = cpuNow() - it->cpuStart;
+                it->open = false;
+                return;
+            }
+        }
+    }
+
+    void StartupTrace::markReady() {
+        if (m_ready) return;
+        m_totalWallMs = wallNow();
+        m_totalCpuMs = cpuNow();
+        m_ready = true;
+    }
+
+    bool StartupTrace::withinBudget() const {
+        return m_ready && m_totalWallMs <= Config::getInstance().startupBudgetMs;
+    }
+
+    void StartupTrace::report(std::ostream& os) const {
+        os << "---- startup report ----\n";
+        os << std::fixed << std::setprecision(1);
+        for (const auto& p : m_phases) {
+            os << std::left << std::setw(24) << p.name << std::right
+               << " wall " << std::setw(8) << p.wallMs << " ms"
+               << "   cpu " << std::setw(8) << p.cpuMs << " ms"
+               << (p.open ? "   (unfinished)" : "") << "\n";
+        }
+        if (m_ready) {
+            os << std::left << std::setw(24) << "time to first frame" << std::right
+               << " wall " << std::setw(8) << m_totalWallMs << " ms"
+               << "   cpu " << std::setw(8) << m_totalCpuMs << " ms\n";
+            os << "budget " << Config::getInstance().startupBudgetMs << " ms: "
+               << (withinBudget() ? "OK" : "EXCEEDED") << "\n";
+        } else {
+            os << "startup did not reach the first game frame\n";
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Bocchi {
+
+    // 启动阶段计时：记录各阶段墙钟时间与进程 CPU 时间，退出时或按命令行参数输出报告
+    //   --startup-report  退出时打印报告
+    //   --startup-check   进入游戏首帧后退出，超出 Config::startupBudgetMs 时返回非零
+    class StartupTrace {
+    public:
+        struct Phase {
+            std::string name;
+            double wallMs = 0.0;
+            double cpuMs = 0.0;
+            bool open = true;
+            double wallStart = 0.0;
+            double cpuStart = 0.0;
+        };
+
+        class Scope {
+        public:
+            explicit Scope(const char* name) : m_name(name) { StartupTrace::getInstance().begin(name); }
+            ~Scope() { StartupTrace::getInstance().end(m_name); }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        private:
+            const char* m_name;
+        };
+
+        static StartupTrace& getInstance() {
+            static StartupTrace instance;
+            return instance;
+        }
+
+        void parseArgs(int argc, char** argv);
+
+        void begin(const std::string& name);
+        void end(const std::string& name);
+
+        // 游戏世界第一帧显示完毕，启动结束
+        void markReady();
+        bool isReady() const { return m_ready; }
+        double totalWallMs() const { return m_totalWallMs; }
+        bool withinBudget() const;
+
+        bool reportRequested() const { return m_reportOnExit; }
+        bool checkRequested() const { return m_checkMode; }
+
+        void report(std::ostream& os) const;
+
+    private:
+        StartupTrace();
+
+        double wallNow() const;
+        static double cpuNow();
+
+        std::chrono::steady_clock::time_point m_origin;
+        std::vector<Phase> m_phases;
+        double m_totalWallMs = 0.0;
+        double m_totalCpuMs = 0.0;
+        bool m_ready = false;
+        bool m_reportOnExit = false;
+        bool m_checkMode = false;
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace Bocchi {
+
+    // 将图片等比缩小到最长边不超过 maxSize（盒式滤波，逐像素按覆盖面积平均）
+    // maxSize 为 0 或图片本身足够小时不做处理；可在后台线程调用
+    inline bool fitImage(sf::Image& image, unsigned int maxSize) {
+        sf::Vector2u src = image.getSize();
+        unsigned int longest = std::max(src.x, src.y);
+        if (maxSize == 0 || longest <= maxSize) return false;
+
+        float ratio = static_cast<float>(longest) / static_cast<float>(maxSize);
+        unsigned int dw = std::max(1u, static_cast<unsigned int>(src.x / ratio + 0.5f));
+        unsigned int dh = std::max(1u, static_cast<unsigned int>(src.y / ratio + 0.5f));
+
+        const unsigned char* in = image.getPixelsPtr();
+        std::vector<unsigned char> out(static_cast<size_t>(dw) * dh * 4);
+
+        for (unsigned int y = 0; y < dh; ++y) {
+            unsigned int y0 = y * src.y / dh;
+            unsigned int y1 = std::max(y0 + 1, (y + 1) * src.y / dh);
+            for (unsigned int x = 0; x < dw; ++x) {
+                unsigned int x0 = x * src.x / dw;
+                unsigned int x1 = std::max(x0 + 1, (x + 1) * src.x / dw);
+
+                // 颜色按 alpha 加权，避免透明像素的底色渗到边缘
+                unsigned long long r = 0, g = 0, b = 0, a = 0;
+                for (unsigned int sy = y0; sy < y1; ++sy) {
+                    const unsigned char* p = in + (static_cast<size_t>(sy) * src.x + x0) * 4;
+                    for (unsigned int sx = x0; sx < x1; ++sx, p += 4) {
+                        r += p[0] * p[3];
+                        g += p[1] * p[3];
+                        b += p[2] * p[3];
+                        a += p[3];
+                    }
+                }
+                unsigned long long count = static_cast<unsigned long long>(x1 - x0) * (y1 - y0);
+                unsigned char* o = out.data() + (static_cast<size_t>(y) * dw + x) * 4;
+                if (a > 0) {
+                    o[0] = static_cast<unsigned char>(r / a);
+                    o[1] = static_cast<unsigned char>(g / a);
+                    o[2] = static_cast<unsigned char>(b / a);
+                }
+                o[3] = static_cast<unsigned char>(a / count);
+            }
+        }
+
+        image.create(dw, dh, out.data());
+        return true;
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Bocchi {
+
+    // 常驻工作线程池：线程在构造时启动、析构时回收，每帧只唤醒不创建
+    // parallelFor 由调用线程一起分担任务，全部完成后才返回；任务回调不做堆分配
+    class WorkerPool {
+    public:
+        explicit WorkerPool(size_t threads) {
+            m_threads.reserve(threads);
+            for (size_t i = 0; i < threads; ++i) {
+                m_threads.emplace_back(&WorkerPool::workerLoop, this);
+            }
+        }
+
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto& t : m_threads) t.join();
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // 含调用线程在内的并行度
+        size_t concurrency() const { return m_threads.size() + 1; }
+
+        // 对 [0, count) 的每个下标调用 fn(i)，不同下标可能在不同线程上执行
+        template <typename Fn>
+        void parallelFor(size_t count, Fn& fn) {
+            run(count, [](void* p, size_t i) { (*static_cast<Fn*>(p))(i); }, &fn);
+        }
+
+    private:
+        using Task = void (*)(void*, size_t);
+
+        void run(size_t count, Task task, void* data) {
+            if (count == 0) return;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_task = task;
+                m_data = data;
+                m_count = count;
+                m_next.store(0, std::memory_order_relaxed);
+                m_pending = m_threads.size();
+                ++m_generation;
+            }
+            m_wake.notify_all();
+            drain(task, data, count);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [&] { return m_pending == 0; });
+        }
+
+        void drain(Task task, void* data, size_t count) {
+            for (size_t i = m_next.fetch_add(1); i < count; i = m_next.fetch_add(1)) {
+                task(data, i);
+            }
+        }
+
+        void workerLoop() {
+            uint64_t seen = 0;
+            for (;;) {
+                Task task;
+                void* data;
+                size_t count;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                    if (m_stop) return;
+                    seen = m_generation;
+                    task = m_task;
+                    data = m_data;
+                    count = m_count;
+                }
+                drain(task, data, count);
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (--m_pending == 0) m_done.notify_one();
+                }
+            }
+        }
+
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        Task m_task = nullptr;
+        void* m_data = nullptr;
+        size_t m_count = 0;
+        size_t m_pending = 0;
+        uint64_t m_generation = 0;
+        std::atomic<size_t> m_next{0};
+        bool m_stop = false;
+    };
+}
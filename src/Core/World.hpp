@@ -1,8 +1,13 @@
 ﻿#pragma once
 #include "Context.hpp"
 #include "System.hpp"
+#include "AllocTracker.h"
+#include "Config.h"
 #include <entt/entt.hpp>
+#include <iomanip>
 #include <memory>
+#include <ostream>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -10,10 +15,20 @@ namespace Bocchi {
 
     enum class WorldType {
         Empty,
+        Loading,
         MainMenu,
         ClassicMode
     };
 
+    // 单个系统的堆分配统计（仅 BOCCHI_ALLOC_TRACKING 时记录）
+    struct SystemAllocStats {
+        std::string_view name;
+        uint64_t allocs = 0;
+        uint64_t bytes = 0;
+        uint64_t steadyAllocs = 0;      // 预热帧之后的分配
+        uint64_t steadyFrames = 0;      // 预热之后发生过分配的帧数
+    };
+
     class World {
     public:
         virtual ~World() = default;
@@ -23,6 +38,10 @@ namespace Bocchi {
 
         void update() {
             // 按注册顺序执行
+            if constexpr (AllocTracker::enabled) {
+                updateTracked();
+                return;
+            }
             for (auto& system : m_systems) {
                 system->update(m_registry);
             }
@@ -30,9 +49,32 @@ namespace Bocchi {
 
         // 添加注册系统
         template<typename T, typename... Args>
-        void addSystem(Args&&... args) {
+        T& addSystem(Args&&... args) {
             static_assert(std::is_base_of_v<System, T>, "T must derive from System");
-            m_systems.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+            auto system = std::make_unique<T>(std::forward<Args>(args)...);
+            T& ref = *system;
+            m_systems.push_back(std::move(system));
+            m_allocStats.push_back({entt::type_id<T>().name()});
+            return ref;
+        }
+
+        // 各系统分配表；预热之后仍有分配的系统标记 STEADY
+        void reportAllocations(std::ostream& out) const {
+            if (!AllocTracker::enabled || m_frames == 0) return;
+            uint64_t steadyFrames = m_frames > m_warmupFrames ? m_frames - m_warmupFrames : 0;
+            out << "[alloc] per-system heap allocations over " << m_frames << " frames ("
+                << steadyFrames << " steady)\n";
+            out << "  " << std::left << std::setw(40) << "system"
+                << std::right << std::setw(12) << "allocs" << std::setw(14) << "bytes"
+                << std::setw(14) << "steady/frame" << "\n";
+            for (const auto& s : m_allocStats) {
+                double perFrame = steadyFrames ? static_cast<double>(s.steadyAllocs) / steadyFrames : 0.0;
+                out << "  " << std::left << std::setw(40) << s.name
+                    << std::right << std::setw(12) << s.allocs << std::setw(14) << s.bytes
+                    << std::setw(14) << std::fixed << std::setprecision(2) << perFrame
+                    << (s.steadyAllocs ? "  STEADY" : "") << "\n";
+            }
+            out.flush();
         }
 
         entt::registry& registry() {return m_registry; }
@@ -42,5 +84,27 @@ namespace Bocchi {
     protected:
         entt::registry m_registry;
         std::vector<std::unique_ptr<System>> m_systems;
+
+    private:
+        void updateTracked() {
+            bool steady = ++m_frames > m_warmupFrames;
+            for (size_t i = 0; i < m_systems.size(); ++i) {
+                AllocTracker::Counters before = AllocTracker::threadCounters();
+                m_systems[i]->update(m_registry);
+                AllocTracker::Counters delta = AllocTracker::threadCounters() - before;
+
+                auto& stats = m_allocStats[i];
+                stats.allocs += delta.count;
+                stats.bytes += delta.bytes;
+                if (steady && delta.count > 0) {
+                    stats.steadyAllocs += delta.count;
+                    stats.steadyFrames++;
+                }
+            }
+        }
+
+        std::vector<SystemAllocStats> m_allocStats;
+        uint64_t m_frames = 0;
+        uint64_t m_warmupFrames = static_cast<uint64_t>(Config::getInstance().allocWarmupFrames);
     };
 }
@@ -1,9 +1,13 @@
 #pragma once
 #include <cmath>
+#include <algorithm>
 #include <random>
 #include "Core/Component.hpp"
 #include "Core/ResourceManager.h"
 #include "Core/Config.h"
+#include "Core/GrowthCurve.h"
+#include "Core/Context.hpp"
+#include "Game/Builders/SegmentPool.hpp"
 #include "Game/Systems/FoodSpawnSystem.hpp"
 
 namespace Bocchi {
@@ -28,6 +32,27 @@ namespace Bocchi {
         };
 
         std::mt19937 m_rng{ std::random_device{}() };
+
+        // 下一条高等级 AI 要用的皮肤，提前预取贴图
+        size_t m_nextSkin = 0;
+        bool m_nextSkinChosen = false;
+
+        ResourceManager* resources(entt::registry& registry) {
+            auto* ctx = registry.ctx().find<GameContext>();
+            return ctx ? ctx->services.res : nullptr;
+        }
+
+        void chooseNextSkin(ResourceManager* res) {
+            std::uniform_int_distribution<size_t> skinDist(0, m_skinPool.size() - 1);
+            m_nextSkin = skinDist(m_rng);
+            m_nextSkinChosen = true;
+            if (res) {
+                const auto& skin = m_skinPool[m_nextSkin];
+                res->prefetchTexture(skin.head);
+                res->prefetchTexture(skin.body);
+                res->prefetchTexture(skin.food);
+            }
+        }
     
     public:
         EntityBuilder() = default;
@@ -53,24 +78,37 @@ namespace Bocchi {
 
             entt::entity snakeHead = registry.create();
             auto& headData = registry.emplace<SnakeHead>(snakeHead);
+            auto& path = registry.emplace<SnakePath>(snakeHead);
+            auto& skin = registry.emplace<SnakeSkin>(snakeHead);
+            registry.emplace<SnakeStats>(snakeHead).currentLength = length;
             
-            headData.headID = headID;
-            headData.bodyID = bodyID;
-            headData.foodID = foodID;
+            skin.headID = headID;
+            skin.bodyID = bodyID;
+            skin.foodID = foodID;
+            skin.color = color;
             headData.targetAngle = rotation;
-            headData.currentLength = length; 
             headData.currentRadius = config.defaultSnakeRadius; 
-            headData.color = color;
+            // 半径从默认值缓动到目标，其余属性直接取当前长度的档位
+            const GrowthStage& stage = growthCurve(registry).at(length);
+            headData.turnSpeed = stage.turnSpeed;
+            headData.spacingFactor = stage.spacingFactor;
             headData.spawnProtectionTime = 5.f;
 
             registry.emplace<Position>(snakeHead, pos);
+            registry.emplace<PrevPosition>(snakeHead, pos);
             registry.emplace<Rotation>(snakeHead, rotation);
             registry.emplace<Speed>(snakeHead, config.defaultSnakeSpeed);
             registry.emplace<CircleCollider>(snakeHead, headData.currentRadius);
-            registry.emplace<MagnetRange>(snakeHead, headData.currentRadius * 2.5f);
+            registry.emplace<MagnetRange>(snakeHead, stage.magnetRange);
+            registry.emplace<RadiusEasing>(snakeHead);
 
             if (isPlayer) registry.emplace<PlayerTag>(snakeHead);
 
+            if (auto* res = resources(registry)) {
+                registry.emplace<SkinHandles>(snakeHead, res->acquireTexture(headID),
+                                              res->acquireTexture(bodyID), res->acquireTexture(foodID));
+            }
+
             float spacing = headData.currentRadius * 2.0f * headData.spacingFactor;
             float rad = rotation * DEG_TO_RAD;
             sf::Vector2f dir(-std::cos(rad), -std::sin(rad));
@@ -78,44 +116,48 @@ namespace Bocchi {
             int pointsToPreGen = length + 5; 
             for (int i = 1; i <= pointsToPreGen; ++i) {
                 sf::Vector2f historyPos = pos + dir * (spacing * (pointsToPreGen - i + 1));
-                headData.pathHistory.push_back(historyPos);
+                path.pathHistory.push_back(historyPos);
             }
 
 
-            for (int i = 0; i < length; ++i) {
-                entt::entity snakeBody = registry.create();
-                
-                registry.emplace<SnakeBody>(snakeBody, snakeHead, i);
-                
-                float offsetDist = spacing * (i + 1);
-                sf::Vector2f bodyPos = pos + dir * offsetDist;
-                registry.emplace<Position>(snakeBody, bodyPos);
-                
-                registry.emplace<CircleCollider>(snakeBody, headData.currentRadius * 0.85f);
-                if (headID == ResID::NONE) {
-                    registry.emplace<ColorComponent>(snakeBody, color);
+            if (config.packedSnakeBodies) {
+                auto& segments = registry.emplace<SnakeSegments>(snakeHead);
+                segments.reserve(static_cast<size_t>(std::max(length, config.expectedSnakeLength)));
+                for (int i = 0; i < length; ++i) {
+                    segments.push(pos + dir * (spacing * (i + 1)), headData.currentRadius * 0.85f, SnakeSegments::Placed);
                 }
+            } else {
+                auto& pool = segmentPool(registry);
+                for (int i = 0; i < length; ++i) {
+                    float offsetDist = spacing * (i + 1);
+                    sf::Vector2f bodyPos = pos + dir * offsetDist;
+                    entt::entity snakeBody = pool.acquire(registry, snakeHead, i, bodyPos, headData.currentRadius * 0.85f);
 
-                headData.bodyEntities.push_back(snakeBody);
-            }
+                    if (headID == ResID::NONE) {
+                        registry.emplace<ColorComponent>(snakeBody, color);
+                    }
+
+                    path.bodyEntities.push_back(snakeBody);
+                }
 
-            if (foodSystem) {
-                for (auto bodyEnt : headData.bodyEntities) {
-                    auto& bPos = registry.get<Position>(bodyEnt).val;
-                    foodSystem->addBodyToGrid(bodyEnt, bPos);
+                if (foodSystem) {
+                    for (auto bodyEnt : path.bodyEntities) {
+                        auto& bPos = registry.get<Position>(bodyEnt).val;
+                        foodSystem->addBodyToGrid(bodyEnt, bPos);
+                    }
                 }
             }
 
-            switch (headData.headID) {
+            switch (skin.headID) {
                 case ResID::head_maodie:
                 case ResID::head_maodie_o:
                 case ResID::head_shantianliang:
-                    registry.emplace<SoundComponent>(snakeHead, ResID::eat_sound_maodie);
+                    skin.eatSoundID = ResID::eat_sound_maodie;
                     break;
                 case ResID::head_xiduoyudai:
                     break;
                 default:
-                    registry.emplace<SoundComponent>(snakeHead, ResID::eat_sound_maodie);
+                    skin.eatSoundID = ResID::eat_sound_maodie;
             }
 
             return snakeHead;
@@ -160,11 +202,12 @@ namespace Bocchi {
 
             
             if (level >= 2 && !m_skinPool.empty()) {
-                std::uniform_int_distribution<size_t> skinDist(0, m_skinPool.size() - 1);
-                const auto& skin = m_skinPool[skinDist(m_rng)];
+                if (!m_nextSkinChosen) chooseNextSkin(resources(registry));
+                const auto& skin = m_skinPool[m_nextSkin];
                 headID = skin.head;
                 bodyID = skin.body;
                 foodID = skin.food;
+                chooseNextSkin(resources(registry));
             } else {
                 static const std::vector<sf::Color> aiColors = {
                     sf::Color::Yellow, sf::Color::Cyan, sf::Color::Magenta, 
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <entt/entt.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Core/Component.hpp"
+
+namespace Bocchi {
+
+    // 身体节回收池：死亡时节实体挂上 ParkedSegment 闲置，生长/新蛇生成时优先取回复用，
+    // 稳定游戏中不再为身体节 create/destroy 实体
+    class SegmentPool {
+    public:
+        entt::entity acquire(entt::registry& reg, entt::entity owner, int index, sf::Vector2f pos, float radius) {
+            if (m_parked.empty()) {
+                entt::entity seg = reg.create();
+                reg.emplace<SnakeBody>(seg, owner, index);
+                reg.emplace<Position>(seg, pos);
+                reg.emplace<CircleCollider>(seg, radius);
+                return seg;
+            }
+
+            entt::entity seg = m_parked.back();
+            m_parked.pop_back();
+            reg.get<SnakeBody>(seg) = SnakeBody(owner, index);
+            reg.get<Position>(seg).val = pos;
+            reg.get<CircleCollider>(seg).radius = radius;
+            reg.remove<ParkedSegment>(seg);
+            return seg;
+        }
+
+        // 调用方需先把节从身体网格移除
+        void release(entt::registry& reg, entt::entity seg) {
+            reg.get<SnakeBody>(seg).headOwner = entt::null;
+            reg.get<Position>(seg).val = {-10000.f, -10000.f};
+            reg.remove<ColorComponent>(seg);
+            reg.emplace<ParkedSegment>(seg);
+            m_parked.push_back(seg);
+        }
+
+        void reserve(size_t count) { m_parked.reserve(count); }
+        size_t parkedCount() const { return m_parked.size(); }
+
+    private:
+        std::vector<entt::entity> m_parked;
+    };
+
+    // 取当前世界的回收池，没有则创建
+    inline SegmentPool& segmentPool(entt::registry& reg) {
+        if (auto* pool = reg.ctx().find<SegmentPool>()) return *pool;
+        return reg.ctx().emplace<SegmentPool>();
+    }
+}
@@ -73,7 +73,7 @@ namespace Bocchi {
 
             float interestFood = 0.f;
             computeDanger(entity, head, pos.val, rot.angle, reg, ctx, slotDirs, danger);
-            computeInterest(entity, head, pos.val, reg, ctx, slotDirs, interest, interestFood);
+            computeInterest(entity, pos.val, reg, ctx, slotDirs, interest, interestFood);
             applyMomentum(rot.angle, ai, danger, interest);
 
             float bestScore = -1e9f;
@@ -163,7 +163,7 @@ namespace Bocchi {
             outDanger = smoothed;
         }
 
-        void computeInterest(entt::entity entity, SnakeHead& head, const sf::Vector2f& pos,
+        void computeInterest(entt::entity entity, const sf::Vector2f& pos,
                              entt::registry& reg, GameContext& ctx,
                              const std::array<sf::Vector2f,24>& slotDirs,
                              std::array<float,24>& outInterest,
@@ -187,7 +187,7 @@ namespace Bocchi {
                 }
             }
 
-            if (head.currentLength > 0) {
+            if (reg.get<SnakeStats>(entity).currentLength > 0) {
                 auto playerView = reg.view<PlayerTag, Position, Rotation, SnakeHead>();
                 if (playerView.begin() != playerView.end()) {
                     auto playerEntity = playerView.front();
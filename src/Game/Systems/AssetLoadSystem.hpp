@@ -0,0 +1,40 @@
+#pragma once
+#include "Core/System.hpp"
+#include "Core/Context.hpp"
+#include "Core/ResourceManager.h"
+#include "Core/App.h"
+#include "Core/StartupTrace.h"
+
+namespace Bocchi {
+    class AssetLoadSystem : public System {
+    public:
+        AssetLoadSystem(WorldType nextWorld = WorldType::ClassicMode)
+            : m_nextWorld(nextWorld) {}
+
+        void update(entt::registry& reg) override {
+            auto& ctx = reg.ctx().get<GameContext>();
+            if (!ctx.services.res || m_requested) return;
+
+            auto& res = *ctx.services.res;
+            if (!m_assetsDone) {
+                if (!res.pollAsyncLoad()) return;
+                m_assetsDone = true;
+                StartupTrace::getInstance().end("assets");
+
+                // 贴图按需加载时，先在加载界面把放得下的贴图预解码上传（ResourceManager::endFrame 上传）
+                StartupTrace::getInstance().begin("textures");
+                res.prefetchWithinBudget();
+            }
+            if (res.prefetchPending() || !ctx.services.app) return;
+
+            StartupTrace::getInstance().end("textures");
+            ctx.services.app->requestChangeWorld(m_nextWorld);
+            m_requested = true;
+        }
+
+    private:
+        WorldType m_nextWorld;
+        bool m_assetsDone = false;
+        bool m_requested = false;
+    };
+}
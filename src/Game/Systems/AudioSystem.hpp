@@ -0,0 +1,103 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "Core/System.hpp"
+#include "Core/Context.hpp"
+#include "Core/Config.h"
+#include "Core/ResourceManager.h"
+
+namespace Bocchi {
+
+    // 固定数量的发声体池：按距离衰减、剔除听不见的事件，满员时按优先级抢占
+    class AudioSystem : public System {
+    public:
+        AudioSystem() {
+            m_voices.resize(static_cast<size_t>(std::max(1, Config::getInstance().maxSoundVoices)));
+        }
+
+        void update(entt::registry& reg) override {
+            auto& ctx = reg.ctx().get<GameContext>();
+            auto& events = ctx.events.sounds;
+            if (events.empty()) return;
+            if (ctx.state.isPaused || !ctx.services.res) {
+                events.clear();
+                return;
+            }
+
+            const auto& config = Config::getInstance();
+            m_pending.clear();
+            for (const auto& e : events) {
+                float volume = attenuate(e, ctx.window.cameraPos, config.soundHearingRange);
+                if (volume < config.soundMinAudibleVolume) continue;
+
+                // 同一帧同一音效只保留最响的一次
+                auto same = std::find_if(m_pending.begin(), m_pending.end(),
+                    [&](const Pending& p) { return p.soundID == e.soundID; });
+                if (same == m_pending.end()) {
+                    m_pending.push_back({e.soundID, volume, e.priority});
+                } else if (std::make_pair(e.priority, volume) > std::make_pair(same->priority, same->volume)) {
+                    same->volume = volume;
+                    same->priority = e.priority;
+                }
+            }
+            events.clear();
+
+            std::sort(m_pending.begin(), m_pending.end(), [](const Pending& a, const Pending& b) {
+                if (a.priority != b.priority) return a.priority > b.priority;
+                return a.volume > b.volume;
+            });
+
+            for (const auto& p : m_pending) {
+                Voice* voice = acquireVoice(p);
+                if (!voice) break;
+                voice->sound.setBuffer(ctx.services.res->get<sf::SoundBuffer>(p.soundID));
+                voice->sound.setVolume(p.volume);
+                voice->sound.play();
+                voice->priority = p.priority;
+                voice->volume = p.volume;
+            }
+        }
+
+    private:
+        struct Voice {
+            sf::Sound sound;
+            SoundPriority priority = SoundPriority::Ambient;
+            float volume = 0.f;
+        };
+
+        struct Pending {
+            ResID soundID;
+            float volume;
+            SoundPriority priority;
+        };
+
+        std::vector<Voice> m_voices;
+        std::vector<Pending> m_pending;
+
+        float attenuate(const SoundEvent& e, sf::Vector2f listener, float range) const {
+            if (e.priority == SoundPriority::Player) return e.volume;
+            float dx = e.pos.x - listener.x;
+            float dy = e.pos.y - listener.y;
+            float t = 1.f - std::sqrt(dx * dx + dy * dy) / range;
+            return t > 0.f ? e.volume * t * t : 0.f;
+        }
+
+        // 优先空闲发声体；否则抢占优先级/音量都更低的那个
+        Voice* acquireVoice(const Pending& p) {
+            Voice* weakest = nullptr;
+            for (auto& v : m_voices) {
+                if (v.sound.getStatus() != sf::Sound::Playing) return &v;
+                if (!weakest || std::make_pair(v.priority, v.volume) < std::make_pair(weakest->priority, weakest->volume)) {
+                    weakest = &v;
+                }
+            }
+            if (weakest && std::make_pair(weakest->priority, weakest->volume) < std::make_pair(p.priority, p.volume)) {
+                weakest->sound.stop();
+                return weakest;
+            }
+            return nullptr;
+        }
+    };
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <entt/entt.hpp>
+#include "Core/System.hpp"
+#include "Core/Component.hpp"
+#include "Core/Context.hpp"
+
+namespace Bocchi {
+
+    // 身体节的拥有型 group：SnakeBody / Position / CircleCollider 三个池中身体节排在前段且顺序一致
+    // 回收池中闲置的节（ParkedSegment）被排除在外
+    // 需在创建任何身体节之前调用一次，之后各处取到的都是同一个 group
+    inline auto bodyGroup(entt::registry& reg) {
+        return reg.group<SnakeBody, Position, CircleCollider>(entt::get<>, entt::exclude<ParkedSegment>);
+    }
+
+    // 保持身体节按 (所属蛇, 节序号) 排序，同一条蛇的身体数据在三个池里连续
+    // 每帧只有少量节被追加（生长）或被尾部节换位（删除），插入排序在近乎有序的输入上接近线性
+    class BodyOrderSystem : public System {
+    public:
+        void update(entt::registry& reg) override {
+            auto& ctx = reg.ctx().get<GameContext>();
+            if (ctx.state.isPaused) return;
+
+            bodyGroup(reg).sort<SnakeBody>([](const SnakeBody& a, const SnakeBody& b) {
+                if (a.headOwner != b.headOwner) return a.headOwner < b.headOwner;
+                return a.segmentIndex < b.segmentIndex;
+            }, entt::insertion_sort{});
+        }
+    };
+}
@@ -6,6 +6,8 @@
 #include "Core/System.hpp"
 #include "Core/Context.hpp"
 #include "Core/Config.h"
+#include "Core/StartupTrace.h"
+#include "Core/FrameArena.h"
 
 namespace Bocchi {
 
@@ -22,6 +24,7 @@ public:
         m_bgGradient.setPrimitiveType(sf::Quads);
         m_bgGradient.resize(4);
 
+        StartupTrace::Scope trace("stars");
         initStarLayer(m_dustStars, 4000, {200, 200, 255, 70});
         initStarLayer(m_midStars, 1500, {255, 255, 255, 160}, true);
         initBigStars(500);
@@ -32,12 +35,17 @@ public:
         m_border.setOutlineThickness(4.f);
 
         m_gridLines.setPrimitiveType(sf::Lines);
+
+        for (int i = 0; i <= BIG_STAR_SEGMENTS; ++i) {
+            float angle = i * 2.f * M_PI_F / BIG_STAR_SEGMENTS;
+            m_unitCircle[i] = {std::cos(angle), std::sin(angle)};
+        }
     }
 
     void update(entt::registry& reg) override {
         auto& ctx = reg.ctx().get<GameContext>();
         auto* window = ctx.window.window;
-        if (!window) return;
+        if (!window || ctx.window.sceneFrozen) return;
 
         m_timer += ctx.time.dt;
         sf::Vector2f winSize = static_cast<sf::Vector2f>(window->getSize());
@@ -53,9 +61,10 @@ public:
 
         if (ctx.window.worldView) window->setView(*ctx.window.worldView);
 
-        drawInfiniteStarLayer(*window, m_dustStars, camPos, 0.02f);
-        drawInfiniteStarLayer(*window, m_midStars,  camPos, 0.10f);
-        drawInfiniteBigStars(*window, camPos, 0.25f);
+        FrameArena& arena = *ctx.services.frameArena;
+        drawInfiniteStarLayer(*window, arena, m_dustStars, camPos, 0.02f);
+        drawInfiniteStarLayer(*window, arena, m_midStars,  camPos, 0.10f);
+        drawInfiniteBigStars(*window, arena, camPos, 0.25f);
 
         drawInfiniteGrid(*window, camPos, winSize);
 
@@ -79,6 +88,24 @@ private:
     sf::Vector2f m_worldSize;
     float m_tileSize, m_gridSpacing, m_timer = 0.f;
     const float M_PI_F = 3.14159265f;
+    static constexpr int BIG_STAR_SEGMENTS = 16;
+    sf::Vector2f m_unitCircle[BIG_STAR_SEGMENTS + 1];
+
+    struct TileRange {
+        int minX, maxX, minY, maxY;
+        size_t count() const { return static_cast<size_t>(maxX - minX + 1) * static_cast<size_t>(maxY - minY + 1); }
+    };
+
+    TileRange visibleTiles(const sf::View& view, sf::Vector2f parallaxShift) const {
+        sf::Vector2f viewSize = view.getSize();
+        sf::Vector2f effectiveCenter = view.getCenter() - parallaxShift;
+        return {
+            static_cast<int>(std::floor((effectiveCenter.x - viewSize.x / 2.f) / m_tileSize)),
+            static_cast<int>(std::ceil((effectiveCenter.x + viewSize.x / 2.f) / m_tileSize)),
+            static_cast<int>(std::floor((effectiveCenter.y - viewSize.y / 2.f) / m_tileSize)),
+            static_cast<int>(std::ceil((effectiveCenter.y + viewSize.y / 2.f) / m_tileSize)),
+        };
+    }
 
     void initStarLayer(std::vector<Star>& layer, int count, sf::Color base, bool colorful = false) {
         std::mt19937 rng(12345);
@@ -119,72 +146,59 @@ private:
         m_bgGradient[3] = { {0.f, size.y}, nebulaColor };
     }
 
-    void drawInfiniteStarLayer(sf::RenderWindow& window, const std::vector<Star>& layer,
-                                    sf::Vector2f camPos, float parallax) {
-            sf::VertexArray va(sf::Points);
-            sf::View currentView = window.getView();
-            sf::Vector2f viewSize = currentView.getSize();
-            sf::Vector2f viewCenter = currentView.getCenter();
-            
-            sf::Vector2f parallaxShift = camPos * (1.0f - parallax); 
-            sf::Vector2f effectiveCenter = viewCenter - parallaxShift;
-
-            int minTileX = static_cast<int>(std::floor((effectiveCenter.x - viewSize.x / 2.f) / m_tileSize));
-            int maxTileX = static_cast<int>(std::ceil((effectiveCenter.x + viewSize.x / 2.f) / m_tileSize));
-            int minTileY = static_cast<int>(std::floor((effectiveCenter.y - viewSize.y / 2.f) / m_tileSize));
-            int maxTileY = static_cast<int>(std::ceil((effectiveCenter.y + viewSize.y / 2.f) / m_tileSize));
-
-            for (int tx = minTileX; tx <= maxTileX; ++tx) {
-                for (int ty = minTileY; ty <= maxTileY; ++ty) {
-                    sf::Vector2f tileBase(tx * m_tileSize, ty * m_tileSize);
-                    for (const auto& s : layer) {
-                        float flash = std::sin(m_timer * 1.5f + s.phase) * 0.3f + 0.7f;
-                        sf::Color c = s.color;
-                        c.a = static_cast<sf::Uint8>(c.a * flash);
-                        va.append(sf::Vertex(s.pos + tileBase + parallaxShift, c));
-                    }
+    // 点和大星星的顶点都从帧内存切出，每层一次 draw
+    void drawInfiniteStarLayer(sf::RenderWindow& window, FrameArena& arena, const std::vector<Star>& layer,
+                               sf::Vector2f camPos, float parallax) {
+        sf::Vector2f parallaxShift = camPos * (1.0f - parallax);
+        TileRange tiles = visibleTiles(window.getView(), parallaxShift);
+
+        FrameVector<sf::Vertex> va{FrameAllocator<sf::Vertex>(arena)};
+        va.reserve(tiles.count() * layer.size());
+
+        for (int tx = tiles.minX; tx <= tiles.maxX; ++tx) {
+            for (int ty = tiles.minY; ty <= tiles.maxY; ++ty) {
+                sf::Vector2f tileBase(tx * m_tileSize, ty * m_tileSize);
+                for (const auto& s : layer) {
+                    float flash = std::sin(m_timer * 1.5f + s.phase) * 0.3f + 0.7f;
+                    sf::Color c = s.color;
+                    c.a = static_cast<sf::Uint8>(c.a * flash);
+                    va.emplace_back(s.pos + tileBase + parallaxShift, c);
                 }
             }
-            window.draw(va, sf::RenderStates::Default);
+        }
+        if (!va.empty()) window.draw(va.data(), va.size(), sf::Points, sf::RenderStates::Default);
     }
 
-    void drawInfiniteBigStars(sf::RenderWindow& window, sf::Vector2f camPos, float parallax) {
-        const int segments = 16;
-        sf::View currentView = window.getView();
-        sf::Vector2f viewSize = currentView.getSize();
-        sf::Vector2f viewCenter = currentView.getCenter();
-
+    void drawInfiniteBigStars(sf::RenderWindow& window, FrameArena& arena, sf::Vector2f camPos, float parallax) {
         sf::Vector2f parallaxShift = camPos * (1.0f - parallax);
-        sf::Vector2f effectiveCenter = viewCenter - parallaxShift;
+        TileRange tiles = visibleTiles(window.getView(), parallaxShift);
 
-        int minTileX = static_cast<int>(std::floor((effectiveCenter.x - viewSize.x / 2.f) / m_tileSize));
-        int maxTileX = static_cast<int>(std::ceil((effectiveCenter.x + viewSize.x / 2.f) / m_tileSize));
-        int minTileY = static_cast<int>(std::floor((effectiveCenter.y - viewSize.y / 2.f) / m_tileSize));
-        int maxTileY = static_cast<int>(std::ceil((effectiveCenter.y + viewSize.y / 2.f) / m_tileSize));
+        // 原先每颗星一个 TriangleFan，合并为一批三角形
+        FrameVector<sf::Vertex> va{FrameAllocator<sf::Vertex>(arena)};
+        va.reserve(tiles.count() * m_bigStars.size() * BIG_STAR_SEGMENTS * 3);
 
-        for (int tx = minTileX; tx <= maxTileX; ++tx) {
-            for (int ty = minTileY; ty <= maxTileY; ++ty) {
+        for (int tx = tiles.minX; tx <= tiles.maxX; ++tx) {
+            for (int ty = tiles.minY; ty <= tiles.maxY; ++ty) {
                 sf::Vector2f tileBase(tx * m_tileSize, ty * m_tileSize);
                 for (const auto& s : m_bigStars) {
                     sf::Vector2f pos = s.pos + tileBase + parallaxShift;
                     float radius = s.size;
                     float flash = std::sin(m_timer * 2.0f + s.phase) * 0.4f + 0.6f;
-                    
+
                     sf::Color coreColor = s.color;
                     coreColor.a = static_cast<sf::Uint8>(255 * flash);
                     sf::Color edgeColor = s.color;
                     edgeColor.a = 0;
 
-                    sf::VertexArray va(sf::TriangleFan);
-                    va.append(sf::Vertex(pos, coreColor));
-                    for (int i = 0; i <= segments; ++i) {
-                        float angle = i * 2.f * M_PI_F / segments;
-                        va.append(sf::Vertex({pos.x + std::cos(angle) * radius, pos.y + std::sin(angle) * radius}, edgeColor));
+                    for (int i = 0; i < BIG_STAR_SEGMENTS; ++i) {
+                        va.emplace_back(pos, coreColor);
+                        va.emplace_back(pos + m_unitCircle[i] * radius, edgeColor);
+                        va.emplace_back(pos + m_unitCircle[i + 1] * radius, edgeColor);
                     }
-                    window.draw(va, sf::RenderStates::Default);
                 }
             }
         }
+        if (!va.empty()) window.draw(va.data(), va.size(), sf::Triangles, sf::RenderStates::Default);
     }
 
         void drawInfiniteGrid(sf::RenderWindow& window, sf::Vector2f camPos, sf::Vector2f winSize) {
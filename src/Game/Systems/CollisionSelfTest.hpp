@@ -0,0 +1,92 @@
+#pragma once
+#include <ostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include <entt/entt.hpp>
+#include "Core/Component.hpp"
+#include "Core/Context.hpp"
+#include "Core/Config.h"
+#include "CollisionSystem.hpp"
+#include "FoodSpawnSystem.hpp"
+
+namespace Bocchi {
+
+    // --collision-selftest：用固定种子搭一批密集的蛇头和身体，分别以串行和线程池跑碰撞，
+    // 逐帧比较产生的碰撞事件。默认 AI 数量达不到并行门槛，这里保证并行路径有人检查
+    namespace CollisionSelfTest {
+
+        using EventList = std::vector<std::pair<entt::entity, entt::entity>>;
+
+        inline EventList simulate(unsigned int seed, int parallelMinHeads, int workers) {
+            auto& config = Config::getInstance();
+            const int savedMinHeads = config.collisionParallelMinHeads;
+            const int savedWorkers = config.collisionWorkers;
+            config.collisionParallelMinHeads = parallelMinHeads;
+            config.collisionWorkers = workers;
+
+            const float mapSize = 2000.f;
+            entt::registry reg;
+            FoodSpawnSystem food(mapSize, mapSize, 250.f);
+            GameContext ctx;
+            ctx.food.foodSystem = &food;
+            ctx.window.mapSize = {mapSize, mapSize};
+            reg.ctx().emplace<GameContext>(ctx);
+
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> place(50.f, mapSize - 50.f);
+            std::uniform_real_distribution<float> radius(10.f, 30.f);
+            std::uniform_real_distribution<float> jitter(-20.f, 20.f);
+            for (int i = 0; i < 48; ++i) {
+                auto head = reg.create();
+                sf::Vector2f pos{place(rng), place(rng)};
+                reg.emplace<SnakeHead>(head);
+                reg.emplace<Position>(head, pos);
+                reg.emplace<PrevPosition>(head, pos - sf::Vector2f{jitter(rng), jitter(rng)});
+                reg.emplace<CircleCollider>(head, radius(rng));
+                for (int k = 0; k < 20; ++k) {
+                    auto body = reg.create();
+                    sf::Vector2f bPos = pos + sf::Vector2f{jitter(rng) * 5.f, jitter(rng) * 5.f};
+                    reg.emplace<SnakeBody>(body, head, k);
+                    reg.emplace<Position>(body, bPos);
+                    reg.emplace<CircleCollider>(body, 15.f);
+                    food.addBodyToGrid(body, bPos);
+                }
+            }
+
+            // 多跑几帧：死亡的头退出快照，线程池跨帧复用
+            CollisionSystem collision;
+            for (int frame = 0; frame < 50; ++frame) {
+                reg.ctx().get<GameContext>().time.frameCount = static_cast<uint32_t>(frame);
+                collision.update(reg);
+            }
+
+            EventList events;
+            for (const auto& e : reg.ctx().get<GameContext>().events.collisions) {
+                events.emplace_back(e.victim, e.killer);
+            }
+
+            config.collisionParallelMinHeads = savedMinHeads;
+            config.collisionWorkers = savedWorkers;
+            return events;
+        }
+
+        // 全部一致返回 0
+        inline int run(std::ostream& os) {
+            int failures = 0;
+            for (unsigned int seed = 1; seed <= 20; ++seed) {
+                EventList serial = simulate(seed, 0, 1);
+                for (int minHeads : {2, 32}) {
+                    EventList parallel = simulate(seed, minHeads, 4);
+                    if (parallel != serial) {
+                        os << "[collision] seed " << seed << " parallelMinHeads " << minHeads
+                           << ": " << parallel.size() << " events vs " << serial.size() << " serial" << std::endl;
+                        failures++;
+                    }
+                }
+            }
+            os << "[collision] self-test " << (failures == 0 ? "passed" : "FAILED") << std::endl;
+            return failures == 0 ? 0 : 1;
+        }
+    }
+}
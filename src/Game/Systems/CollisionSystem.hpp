@@ -1,59 +1,187 @@
 #pragma once
+#include <cassert>
 #include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
 #include "Core/Component.hpp"
 #include "Core/System.hpp"
+#include "Core/Config.h"
+#include "Core/WorkerPool.h"
 #include "FoodSpawnSystem.hpp"
 
 namespace Bocchi{
+    // 碰撞分三步：先把参与检测的蛇头拍成快照，再对每个头独立做窄检测（只读，可分块并行），
+    // 最后按快照顺序合并结果、写死亡标记和事件，结果与线程数无关
+    // 蛇头按本帧从上一位置到当前位置的扫掠圆（胶囊）检测，低帧率或加速时也不会穿过身体
     class CollisionSystem : public System {
     public:
         void update(entt::registry& reg) override {
             auto& ctx = reg.ctx().get<GameContext>();
-            auto headView = reg.view<SnakeHead, Position, CircleCollider>();
             auto* foodSys = ctx.food.foodSystem;
             if (!foodSys) return;
 
             if (ctx.state.isPaused) return;
 
-            headView.each([&](auto entity, auto& head, auto& pos, auto& col) {
+            m_heads.clear();
+            auto headView = reg.view<SnakeHead, Position, PrevPosition, CircleCollider>();
+            headView.each([&](auto entity, auto& head, auto& pos, auto& prevPos, auto& col) {
                 if (head.isDead) return;
                 if (head.spawnProtectionTime > 0) return;
+                m_heads.push_back({entity, prevPos.val, pos.val, col.radius});
+            });
+            if (m_heads.empty()) return;
+
+            m_hits.assign(m_heads.size(), Hit{});
+            const entt::registry& snapshot = reg;
+            sf::Vector2f mapSize = ctx.window.mapSize;
 
-                if (pos.val.x < 0 || pos.val.x > ctx.window.mapSize.x || pos.val.y < 0 || pos.val.y > ctx.window.mapSize.y) {
-                    head.isDead = true;
-                    return;
+            size_t workers = workerCount(m_heads.size());
+            if (workers <= 1) {
+                narrowphase(snapshot, *foodSys, mapSize, 0, m_heads.size());
+            } else {
+                if (!m_pool || m_pool->concurrency() != workers) {
+                    m_pool = std::make_unique<WorkerPool>(workers - 1);
                 }
+                size_t chunk = (m_heads.size() + workers - 1) / workers;
+                size_t chunks = (m_heads.size() + chunk - 1) / chunk;
+                auto job = [&](size_t c) {
+                    size_t begin = c * chunk;
+                    narrowphase(snapshot, *foodSys, mapSize, begin, std::min(m_heads.size(), begin + chunk));
+                };
+                m_pool->parallelFor(chunks, job);
+                assert(matchesSerial(snapshot, *foodSys, mapSize) && "parallel narrowphase diverged from serial");
+            }
+
+            // 每条蛇至多产生一条事件
+            for (size_t i = 0; i < m_heads.size(); ++i) {
+                if (!m_hits[i].dead) continue;
+                const auto& snap = m_heads[i];
+                reg.get<SnakeHead>(snap.entity).isDead = true;
+                ctx.events.collisions.push_back({snap.entity, m_hits[i].killer, snap.pos, ctx.time.frameCount});
+            }
+        }
+
+    private:
+        struct HeadSnapshot {
+            entt::entity entity;
+            sf::Vector2f from;
+            sf::Vector2f pos;
+            float radius;
+        };
+
+        struct Hit {
+            bool dead = false;
+            entt::entity killer = entt::null;
+        };
+
+        // 蛇头太少时线程调度开销大于收益，直接串行
+        static size_t workerCount(size_t heads) {
+            const auto& config = Config::getInstance();
+            if (config.collisionParallelMinHeads <= 0 || heads < static_cast<size_t>(config.collisionParallelMinHeads)) return 1;
+            size_t workers = config.collisionWorkers > 0
+                ? static_cast<size_t>(config.collisionWorkers)
+                : std::max(1u, std::thread::hardware_concurrency());
+            return std::min(workers, heads);
+        }
+
+        // 调试构建下把并行结果与串行重算逐项比对
+        bool matchesSerial(const entt::registry& reg, const FoodSpawnSystem& foodSys, sf::Vector2f mapSize) const {
+            for (size_t i = 0; i < m_heads.size(); ++i) {
+                Hit serial = testHead(reg, foodSys, mapSize, i);
+                if (serial.dead != m_hits[i].dead || serial.killer != m_hits[i].killer) return false;
+            }
+            return true;
+        }
+
+        // 只读 registry 与网格，只写 m_hits[begin, end)
+        void narrowphase(const entt::registry& reg, const FoodSpawnSystem& foodSys, sf::Vector2f mapSize,
+                         size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                m_hits[i] = testHead(reg, foodSys, mapSize, i);
+            }
+        }
+
+        Hit testHead(const entt::registry& reg, const FoodSpawnSystem& foodSys, sf::Vector2f mapSize, size_t i) const {
+            const HeadSnapshot& self = m_heads[i];
+            const sf::Vector2f& pos = self.pos;
 
-                int gx = static_cast<int>(pos.val.x / foodSys->getCellSize());
-                int gy = static_cast<int>(pos.val.y / foodSys->getCellSize());
+            if (pos.x < 0 || pos.x > mapSize.x || pos.y < 0 || pos.y > mapSize.y) {
+                return {true, entt::null};
+            }
 
-                for (int x = gx - 1; x <= gx + 1; ++x) {
-                    for (int y = gy - 1; y <= gy + 1; ++y) {
-                        const auto& bodies = foodSys->getBodiesInCell(x, y);
-                        for (auto bEnt : bodies) {
-                            if (!reg.valid(bEnt)) continue;
-                            auto& bData = reg.get<SnakeBody>(bEnt);
+            // 覆盖整段轨迹的格子，再向外扩一格容纳身体半径
+            float cellSize = foodSys.getCellSize();
+            int minX = static_cast<int>(std::min(self.from.x, pos.x) / cellSize) - 1;
+            int maxX = static_cast<int>(std::max(self.from.x, pos.x) / cellSize) + 1;
+            int minY = static_cast<int>(std::min(self.from.y, pos.y) / cellSize) - 1;
+            int maxY = static_cast<int>(std::max(self.from.y, pos.y) / cellSize) + 1;
 
-                            auto* ownerHead = reg.try_get<SnakeHead>(bData.headOwner);
-                            if (!ownerHead || ownerHead->spawnProtectionTime > 0) continue;     
+            for (int x = minX; x <= maxX; ++x) {
+                for (int y = minY; y <= maxY; ++y) {
+                    const auto& bodies = foodSys.getBodiesInCell(x, y);
+                    for (auto bEnt : bodies) {
+                        if (!reg.valid(bEnt)) continue;
+                        const auto& bData = reg.get<SnakeBody>(bEnt);
 
-                            if (bData.headOwner == entity) continue;
+                        const auto* ownerHead = reg.try_get<SnakeHead>(bData.headOwner);
+                        if (!ownerHead || ownerHead->spawnProtectionTime > 0) continue;
 
-                            auto& bPos = reg.get<Position>(bEnt);
-                            auto& bCol = reg.get<CircleCollider>(bEnt);
-                            
-                            float dx = pos.val.x - bPos.val.x;
-                            float dy = pos.val.y - bPos.val.y;
-                            float distSq = dx * dx + dy * dy;
+                        if (bData.headOwner == self.entity) continue;
 
-                            if (distSq < std::pow(col.radius + bCol.radius, 2)) {
-                                head.isDead = true;
-                                return;
-                            }
+                        const auto& bPos = reg.get<Position>(bEnt);
+                        const auto& bCol = reg.get<CircleCollider>(bEnt);
+
+                        float reach = self.radius + bCol.radius;
+                        if (segmentDistSq(self.from, pos, bPos.val) < reach * reach) {
+                            return {true, bData.headOwner};
+                        }
+                    }
+
+                    for (const auto& ref : foodSys.getSegmentsInCell(x, y)) {
+                        if (ref.owner == self.entity) continue;
+                        const auto* ownerHead = reg.try_get<SnakeHead>(ref.owner);
+                        if (!ownerHead || ownerHead->spawnProtectionTime > 0) continue;
+                        const auto* segments = reg.try_get<SnakeSegments>(ref.owner);
+                        if (!segments || ref.index >= segments->size()) continue;
+
+                        float reach = self.radius + segments->radii[ref.index];
+                        if (segmentDistSq(self.from, pos, segments->positions[ref.index]) < reach * reach) {
+                            return {true, ref.owner};
                         }
                     }
                 }
-            });
+            }
+
+            // 头对头：半径小的一方死亡，差不多大则同归于尽。蛇头数量有上限，直接两两比较
+            // 两个头都在动，取相对位移的轨迹求本帧内的最近距离
+            const float tieEpsilon = 0.5f;
+            for (size_t j = 0; j < m_heads.size(); ++j) {
+                if (j == i) continue;
+                const HeadSnapshot& other = m_heads[j];
+                float reach = self.radius + other.radius;
+                if (segmentDistSq(self.from - other.from, pos - other.pos, {0.f, 0.f}) >= reach * reach) continue;
+                if (self.radius < other.radius + tieEpsilon) {
+                    return {true, other.entity};
+                }
+            }
+
+            return {};
         }
+
+        // 点 c 到线段 ab 的最短距离平方；a == b 时退化为点距
+        static float segmentDistSq(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c) {
+            sf::Vector2f ab = b - a;
+            sf::Vector2f ac = c - a;
+            float lenSq = ab.x * ab.x + ab.y * ab.y;
+            float t = lenSq > 0.f ? std::clamp((ac.x * ab.x + ac.y * ab.y) / lenSq, 0.f, 1.f) : 0.f;
+            sf::Vector2f d = ac - ab * t;
+            return d.x * d.x + d.y * d.y;
+        }
+
+        std::vector<HeadSnapshot> m_heads;
+        std::vector<Hit> m_hits;
+        std::unique_ptr<WorkerPool> m_pool;
     };
 }
@@ -1,47 +1,87 @@
 #pragma once
 #include "Core/System.hpp"
 #include "Core/Component.hpp"
+#include "Game/Builders/SegmentPool.hpp"
 
 namespace Bocchi{
     class DeathSystem : public System{
     public:
         void update(entt::registry& reg) override {
             auto& ctx = reg.ctx().get<GameContext>();
-            auto view = reg.view<SnakeHead, Position>();
+            auto& events = ctx.events.collisions;
+            if (events.empty()) return;
+            auto& pool = segmentPool(reg);
 
-            view.each([&](auto entity, auto& head, auto& pos) {
-                if (!head.isDead) return;
+            // 先结算全部击杀，再销毁受害者：同帧互撞时凶手可能也在队列里
+            for (const auto& event : events) {
+                creditKill(reg, event, ctx);
+            }
 
-                for (auto bodyEnt : head.bodyEntities) {
+            // 只处理本帧的碰撞事件，没有蛇死亡时不遍历蛇头
+            for (const auto& event : events) {
+                entt::entity entity = event.victim;
+                if (!reg.valid(entity)) continue;
+                auto& head = reg.get<SnakeHead>(entity);
+                auto& path = reg.get<SnakePath>(entity);
+                auto& skin = reg.get<SnakeSkin>(entity);
+
+                // 先收集整条蛇的身体位置，再一次性批量生成掉落
+                m_dropPositions.clear();
+                for (auto bodyEnt : path.bodyEntities) {
                     if (reg.valid(bodyEnt)) {
                         auto& bPos = reg.get<Position>(bodyEnt).val;
 
                         if (ctx.food.foodSystem) {
                             ctx.food.foodSystem->removeBodyFromGrid(bodyEnt, bPos);
                         }
+                        m_dropPositions.push_back(bPos);
 
-                        if (ctx.food.foodSystem) {
-                            ctx.food.foodSystem->spawnFood(
-                            bPos, 
-                            FoodType::MassDrop, 
-                            head.currentRadius * 0.1f,
-                            head.foodID,
-                            head.color,
-                            head.currentRadius * 0.8f
-                            );
-                        }
+                        pool.release(reg, bodyEnt);
+                    }
+                }
+                path.bodyEntities.clear();
 
-                        reg.destroy(bodyEnt);
+                if (auto* segments = reg.try_get<SnakeSegments>(entity)) {
+                    for (size_t i = 0; i < segments->size(); ++i) {
+                        if (segments->flags[i] & SnakeSegments::Placed) m_dropPositions.push_back(segments->positions[i]);
                     }
+                    // 玩家头部保留，身体数组清空；网格在下一帧重建时自然移除
+                    segments->clear();
+                }
+
+                if (ctx.food.foodSystem) {
+                    ctx.food.foodSystem->spawnFoodBatch(
+                        m_dropPositions.data(),
+                        m_dropPositions.size(),
+                        head.currentRadius * 0.1f,
+                        skin.foodID,
+                        skin.color,
+                        head.currentRadius * 0.8f
+                    );
                 }
-                head.bodyEntities.clear();
 
                 if (reg.all_of<PlayerTag>(entity)) {
                     handlePlayerDeath(reg, entity, head, ctx);
                 } else {
                     reg.destroy(entity);
                 }
-            });
+            }
+            events.clear();
+        }
+
+        // 击杀计入凶手的统计，并在撞击点播放凶手的进食音效
+        void creditKill(entt::registry& reg, const CollisionEvent& event, GameContext& ctx) {
+            if (!reg.valid(event.killer)) return;
+            auto* stats = reg.try_get<SnakeStats>(event.killer);
+            if (!stats) return;
+            stats->kills++;
+
+            ResID sound = reg.get<SnakeSkin>(event.killer).eatSoundID;
+            if (sound != ResID::NONE) {
+                bool involvesPlayer = reg.all_of<PlayerTag>(event.killer) || reg.all_of<PlayerTag>(event.victim);
+                ctx.events.sounds.push_back({sound, event.pos, 80.f,
+                    involvesPlayer ? SoundPriority::Player : SoundPriority::Ambient});
+            }
         }
 
 
@@ -50,6 +90,9 @@ namespace Bocchi{
             
         }
 
+    private:
+        std::vector<sf::Vector2f> m_dropPositions;
+
 
     };
 }
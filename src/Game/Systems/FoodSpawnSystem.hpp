@@ -4,6 +4,9 @@
 #include <cmath>
 #include <algorithm>
 #include <unordered_set>
+#include <unordered_map>
+#include <array>
+#include <random>
 #include <SFML/Graphics.hpp>
 #include <entt/entt.hpp>
 #include "Core/System.hpp"
@@ -11,6 +14,7 @@
 #include "Core/Context.hpp"
 #include "Core/ResourceManager.h"
 #include "Core/Config.h"
+#include "Core/GrowthCurve.h"
 
 namespace Bocchi {
 
@@ -19,6 +23,13 @@ namespace Bocchi {
         MassDrop,
     };
 
+    // 紧凑身体节在网格中的引用：所属蛇 + 数组下标，附带入格时的位置供 AI 查询
+    struct SegmentRef {
+        entt::entity owner;
+        uint32_t index;
+        sf::Vector2f pos;
+    };
+
     struct FoodItem {
         sf::Vector2f pos;
         FoodType type;
@@ -35,7 +46,9 @@ namespace Bocchi {
         std::vector<FoodItem> m_foods;
         std::vector<std::list<size_t>> m_foodGrid;
         std::vector<std::unordered_set<entt::entity>> m_bodyGrid;
+        std::vector<std::vector<SegmentRef>> m_segmentGrid;
         std::vector<size_t> m_freeIndices;
+        std::minstd_rand m_dropRng{std::random_device{}()};
 
         int MAX_TOTAL_FOOD;
         int MIN_PER_CELL;
@@ -57,6 +70,7 @@ namespace Bocchi {
             
             m_foodGrid.resize(m_cols * m_rows);
             m_bodyGrid.resize(m_cols * m_rows);
+            m_segmentGrid.resize(m_cols * m_rows);
 
             m_colorPalette = {
                 sf::Color(255, 100, 100), sf::Color(100, 255, 100),
@@ -66,14 +80,43 @@ namespace Bocchi {
         }
 
         float getCellSize() const { return m_cellSize; }
+        void reserveFoods(size_t count) { m_foods.reserve(count); }
+        size_t foodSlots() const { return m_foods.size(); }
         int getCols() const { return m_cols; }
         int getRows() const { return m_rows; }
 
+        // 矩形覆盖的格子范围（已裁剪到地图内），margin 为额外外扩的格数
+        void getCellRange(const sf::FloatRect& rect, int& minX, int& minY, int& maxX, int& maxY, int margin = 0) const {
+            minX = std::max(0, static_cast<int>(std::floor(rect.left / m_cellSize)) - margin);
+            minY = std::max(0, static_cast<int>(std::floor(rect.top / m_cellSize)) - margin);
+            maxX = std::min(m_cols - 1, static_cast<int>(std::floor((rect.left + rect.width) / m_cellSize)) + margin);
+            maxY = std::min(m_rows - 1, static_cast<int>(std::floor((rect.top + rect.height) / m_cellSize)) + margin);
+        }
+
         const std::unordered_set<entt::entity>& getBodiesInCell(int gx, int gy) const {
             static const std::unordered_set<entt::entity> empty;
             if (gx < 0 || gx >= m_cols || gy < 0 || gy >= m_rows) return empty;
             return m_bodyGrid[gy * m_cols + gx];
         }
+        // 紧凑身体的网格：每帧由 SnakeBodyMoveSystem 清空后整体重建，格子容量跨帧保留
+        const std::vector<SegmentRef>& getSegmentsInCell(int gx, int gy) const {
+            static const std::vector<SegmentRef> empty;
+            if (gx < 0 || gx >= m_cols || gy < 0 || gy >= m_rows) return empty;
+            return m_segmentGrid[gy * m_cols + gx];
+        }
+
+        void clearSegmentGrid() {
+            for (auto& cell : m_segmentGrid) cell.clear();
+        }
+
+        void addSegmentToGrid(entt::entity owner, uint32_t index, sf::Vector2f pos) {
+            int gx = static_cast<int>(pos.x / m_cellSize);
+            int gy = static_cast<int>(pos.y / m_cellSize);
+            if (gx >= 0 && gx < m_cols && gy >= 0 && gy < m_rows) {
+                m_segmentGrid[gy * m_cols + gx].push_back({owner, index, pos});
+            }
+        }
+
         void updateBodyInGrid(entt::entity ent, sf::Vector2f oldPos, sf::Vector2f newPos) {
             int ox = static_cast<int>(oldPos.x / m_cellSize);
             int oy = static_cast<int>(oldPos.y / m_cellSize);
@@ -115,10 +158,10 @@ namespace Bocchi {
                 finalPos.y = std::clamp(finalPos.y, 0.f, m_mapHeight);
             }
 
+            // 空闲槽位在被吃掉时已移出网格，直接复用
             if (!m_freeIndices.empty()) {
                 index = m_freeIndices.back();
                 m_freeIndices.pop_back();
-                removeFoodFromGrid(index);
                 m_foods[index] = {finalPos, type, energy, color, resID, true, radius};
             } else {
                 index = m_foods.size();
@@ -127,16 +170,59 @@ namespace Bocchi {
             addFoodToGrid(index);
         }
 
+        // 死亡掉落批量生成：一次性分配槽位并入格。掉落数超过 Config::deathDropCoalesceThreshold 时，
+        // 沿身体顺序把相邻的 k 节合并为一份（能量累加，半径略放大），总数不超过阈值
+        void spawnFoodBatch(const sf::Vector2f* positions, size_t count, float energy, ResID resID, sf::Color color, float radius) {
+            if (count == 0) return;
+
+            const size_t threshold = static_cast<size_t>(std::max(0, Config::getInstance().deathDropCoalesceThreshold));
+            size_t group = (threshold > 0 && count > threshold) ? (count + threshold - 1) / threshold : 1;
+            size_t dropCount = (count + group - 1) / group;
+
+            // 先用空闲槽位，不够的部分一次性扩容
+            size_t reused = std::min(dropCount, m_freeIndices.size());
+            size_t firstNew = m_foods.size();
+            m_foods.resize(firstNew + (dropCount - reused));
+
+            std::uniform_real_distribution<float> angleDist(0.f, 2.f * 3.14159f);
+            std::uniform_real_distribution<float> jitterDist(0.f, 25.f);
+
+            for (size_t d = 0; d < dropCount; ++d) {
+                size_t begin = d * group;
+                size_t end = std::min(count, begin + group);
+                sf::Vector2f center{0.f, 0.f};
+                for (size_t i = begin; i < end; ++i) center += positions[i];
+                float merged = static_cast<float>(end - begin);
+                center /= merged;
+
+                float angle = angleDist(m_dropRng);
+                float dist = jitterDist(m_dropRng);
+                center.x = std::clamp(center.x + std::cos(angle) * dist, 0.f, m_mapWidth);
+                center.y = std::clamp(center.y + std::sin(angle) * dist, 0.f, m_mapHeight);
+
+                size_t index;
+                if (d < reused) {
+                    index = m_freeIndices.back();
+                    m_freeIndices.pop_back();
+                } else {
+                    index = firstNew + (d - reused);
+                }
+                m_foods[index] = {center, FoodType::MassDrop, energy * merged, color, resID, true,
+                                  radius * std::min(std::sqrt(merged), 1.5f)};
+                addFoodToGrid(index);
+            }
+        }
+
         void update(entt::registry& reg) override {
             auto& ctx = reg.ctx().get<GameContext>();
             if (ctx.state.isPaused) return;
             if (ctx.food.foodSystem != this) ctx.food.foodSystem = this;
 
+            const auto& curve = growthCurve(reg);
             auto snakeView = reg.view<Position, SnakeHead, CircleCollider, MagnetRange>();
 
             for (auto snake : snakeView) {
                 auto& sPos = snakeView.get<Position>(snake).val;
-                auto& sHead = snakeView.get<SnakeHead>(snake);
                 float sRadius = snakeView.get<CircleCollider>(snake).radius;
                 float sMagnet = snakeView.get<MagnetRange>(snake).range;
 
@@ -160,16 +246,14 @@ namespace Bocchi {
                             float dy = sPos.y - food.pos.y;
                             float distSq = dx * dx + dy * dy;
                             if (distSq < std::pow(sRadius + food.radius, 2)) {
-                                applyCollectionEffect(sHead, food);
-                                if (reg.all_of<PlayerTag, SoundComponent>(snake)) {
-                                    auto& sc = reg.get<SoundComponent>(snake);
-                                    ResID finalID = (sc.soundID != ResID::NONE) ? sc.soundID : ResID::eat_sound_maodie;
-                                    const auto& buffer = ctx.services.res->get<sf::SoundBuffer>(finalID);
-                                    sc.sound.setBuffer(buffer);
-                                    if (food.energyValue > 1) {
-                                        sc.sound.setVolume(50);
-                                        sc.sound.play();
-                                    }                               
+                                if (applyCollectionEffect(reg.get<SnakeStats>(snake), food, curve)) {
+                                    ctx.events.growth.push_back({snake});
+                                }
+                                ResID eatSound = reg.get<SnakeSkin>(snake).eatSoundID;
+                                if (food.energyValue > 1 && eatSound != ResID::NONE) {
+                                    bool isPlayer = reg.all_of<PlayerTag>(snake);
+                                    ctx.events.sounds.push_back({eatSound, sPos, 50.f,
+                                        isPlayer ? SoundPriority::Player : SoundPriority::Ambient});
                                 }
                                 food.active = false;
                                 m_freeIndices.push_back(*it);
@@ -199,33 +283,99 @@ namespace Bocchi {
         void render(GameContext& ctx) {
             auto* window = ctx.window.window;
             auto* res = ctx.services.res;
-            if (!window || !res) return;
+            if (!window || !res || ctx.window.sceneFrozen) return;
             if (ctx.window.worldView) window->setView(*ctx.window.worldView);
 
-            static sf::CircleShape dot;
-            static sf::Sprite sprite;
-            for (const auto& food : m_foods) {
-                if (!food.active) continue;
-                if (food.resID != ResID::NONE) {
-                    auto& tex = res->get<sf::Texture>(food.resID);
-                    sprite.setTexture(tex, true);
-                    sprite.setOrigin(tex.getSize().x / 2.f, tex.getSize().y / 2.f);
-                    sprite.setPosition(food.pos);
-                    float scale = food.radius / tex.getSize().x * 3.5f;
-                    sprite.setScale(scale, scale);
-                    window->draw(sprite);
-                } else {
-                    dot.setFillColor(food.color);
-                    float r = (food.type == FoodType::MassDrop ? food.radius : 6.f);
-                    dot.setRadius(r);
-                    dot.setOrigin(r, r);
-                    dot.setPosition(food.pos);
-                    window->draw(dot);
+            // 只查询与视口相交的格子，外扩一格以覆盖被磁吸拖出原格子的食物
+            int minX = 0, minY = 0, maxX = m_cols - 1, maxY = m_rows - 1;
+            sf::FloatRect viewBounds(0.f, 0.f, m_mapWidth, m_mapHeight);
+            if (ctx.window.worldView) {
+                sf::Vector2f center = ctx.window.worldView->getCenter();
+                sf::Vector2f size = ctx.window.worldView->getSize();
+                viewBounds = sf::FloatRect(center.x - size.x / 2.f - FOOD_VIEW_MARGIN,
+                                           center.y - size.y / 2.f - FOOD_VIEW_MARGIN,
+                                           size.x + FOOD_VIEW_MARGIN * 2.f,
+                                           size.y + FOOD_VIEW_MARGIN * 2.f);
+                getCellRange(viewBounds, minX, minY, maxX, maxY, 1);
+            }
+
+            // 屏幕上过小的食物退化为点精灵
+            float pixelScale = 1.f;
+            if (ctx.window.worldView && ctx.window.worldView->getSize().x > 0.f) {
+                pixelScale = static_cast<float>(window->getSize().x) / ctx.window.worldView->getSize().x;
+            }
+            const float pointRadius = Config::getInstance().lodFoodPointPixelRadius / pixelScale;
+
+            m_dotBatch.clear();
+            m_pointBatch.clear();
+            for (auto& batch : m_spriteBatches) batch.second.clear();
+
+            for (int y = minY; y <= maxY; ++y) {
+                for (int x = minX; x <= maxX; ++x) {
+                    for (size_t idx : m_foodGrid[y * m_cols + x]) {
+                        const auto& food = m_foods[idx];
+                        if (!food.active || !viewBounds.contains(food.pos)) continue;
+                        if (food.radius < pointRadius) {
+                            m_pointBatch.append(sf::Vertex(food.pos, food.color));
+                        } else if (food.resID != ResID::NONE) {
+                            appendSprite(res->get<sf::Texture>(food.resID), food);
+                        } else {
+                            appendDot(food);
+                        }
+                    }
                 }
             }
+
+            window->draw(m_pointBatch);
+            window->draw(m_dotBatch);
+            for (auto& [id, batch] : m_spriteBatches) {
+                if (batch.getVertexCount() == 0) continue;
+                sf::RenderStates states;
+                states.texture = &res->get<sf::Texture>(id);
+                window->draw(batch, states);
+            }
         }
 
     private:
+        static constexpr float FOOD_VIEW_MARGIN = 150.f;
+        static constexpr int DOT_SEGMENTS = 10;
+
+        sf::VertexArray m_dotBatch{sf::Triangles};
+        sf::VertexArray m_pointBatch{sf::Points};
+        std::unordered_map<ResID, sf::VertexArray> m_spriteBatches;
+
+        void appendDot(const FoodItem& food) {
+            static const std::array<sf::Vector2f, DOT_SEGMENTS + 1> unitCircle = []() {
+                std::array<sf::Vector2f, DOT_SEGMENTS + 1> pts{};
+                for (int i = 0; i <= DOT_SEGMENTS; ++i) {
+                    float a = i * 2.f * 3.14159265f / DOT_SEGMENTS;
+                    pts[i] = {std::cos(a), std::sin(a)};
+                }
+                return pts;
+            }();
+
+            float r = (food.type == FoodType::MassDrop ? food.radius : 6.f);
+            for (int i = 0; i < DOT_SEGMENTS; ++i) {
+                m_dotBatch.append(sf::Vertex(food.pos, food.color));
+                m_dotBatch.append(sf::Vertex(food.pos + unitCircle[i] * r, food.color));
+                m_dotBatch.append(sf::Vertex(food.pos + unitCircle[i + 1] * r, food.color));
+            }
+        }
+
+        void appendSprite(const sf::Texture& tex, const FoodItem& food) {
+            auto& batch = m_spriteBatches[food.resID];
+            if (batch.getPrimitiveType() != sf::Quads) batch.setPrimitiveType(sf::Quads);
+
+            sf::Vector2f texSize(static_cast<float>(tex.getSize().x), static_cast<float>(tex.getSize().y));
+            float scale = food.radius / texSize.x * 3.5f;
+            sf::Vector2f half = texSize * (scale / 2.f);
+
+            batch.append(sf::Vertex({food.pos.x - half.x, food.pos.y - half.y}, {0.f, 0.f}));
+            batch.append(sf::Vertex({food.pos.x + half.x, food.pos.y - half.y}, {texSize.x, 0.f}));
+            batch.append(sf::Vertex({food.pos.x + half.x, food.pos.y + half.y}, {texSize.x, texSize.y}));
+            batch.append(sf::Vertex({food.pos.x - half.x, food.pos.y + half.y}, {0.f, texSize.y}));
+        }
+
         void handleMapGeneration() {
             int activeCount = 0;
             for(const auto& f : m_foods) if(f.active) activeCount++;
@@ -268,16 +418,19 @@ namespace Bocchi {
             }
         }
 
-        void applyCollectionEffect(SnakeHead& head, const FoodItem& food) {
-            head.energyAccumulator += food.energyValue;
-            head.totalEnergy += food.energyValue;
+        // 返回本次拾取是否攒够了一节成长
+        bool applyCollectionEffect(SnakeStats& stats, const FoodItem& food, const GrowthCurve& curve) {
+            stats.energyAccumulator += food.energyValue;
+            stats.totalEnergy += food.energyValue;
 
-            float growthThreshold = 10.f + (head.currentLength * 0.5f);
+            float growthThreshold = curve.at(stats.currentLength).growthThreshold;
 
-            if (head.energyAccumulator >= growthThreshold) { 
-                head.pendingGrowth += 1;
-                head.energyAccumulator -= growthThreshold;
+            if (stats.energyAccumulator >= growthThreshold) { 
+                stats.pendingGrowth += 1;
+                stats.energyAccumulator -= growthThreshold;
+                return true;
             }
+            return false;
 
         }   
             
@@ -290,6 +443,7 @@ namespace Bocchi {
                 for (int y = gy - 1; y <= gy + 1; ++y) {
                     if (x < 0 || x >= m_cols || y < 0 || y >= m_rows) continue;
                     if (!m_bodyGrid[y * m_cols + x].empty()) return false; 
+                    if (!m_segmentGrid[y * m_cols + x].empty()) return false;
                 }
             }
             return true;
@@ -321,7 +475,8 @@ namespace Bocchi {
             return found;
         }
 
-        sf::Vector2f getAverageBodyOffset(sf::Vector2f pos, float range) {
+        // 两种身体表示都取身体节的实际位置，结果不随 packedSnakeBodies 变化
+        sf::Vector2f getAverageBodyOffset(const entt::registry& reg, sf::Vector2f pos, float range) {
             int r = static_cast<int>(range / m_cellSize) + 1;
             int gx = static_cast<int>(pos.x / m_cellSize);
             int gy = static_cast<int>(pos.y / m_cellSize);
@@ -332,7 +487,13 @@ namespace Bocchi {
                 for (int y = gy - r; y <= gy + r; ++y) {
                     if (x < 0 || x >= m_cols || y < 0 || y >= m_rows) continue;
                     for (auto ent : m_bodyGrid[y * m_cols + x]) {
-                        sum += sf::Vector2f(static_cast<float>(x) * m_cellSize, static_cast<float>(y) * m_cellSize);
+                        const auto* bPos = reg.try_get<Position>(ent);
+                        if (!bPos) continue;
+                        sum += bPos->val;
+                        count++;
+                    }
+                    for (const auto& ref : m_segmentGrid[y * m_cols + x]) {
+                        sum += ref.pos;
                         count++;
                     }
                 }
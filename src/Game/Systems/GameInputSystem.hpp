@@ -37,10 +37,10 @@ namespace Bocchi {
 
             bool isMousePressed = sf::Mouse::isButtonPressed(sf::Mouse::Left);
             
-            auto view = reg.view<Position, SnakeHead, Speed, PlayerTag>();
-            view.each([&](auto entity, auto& pos, auto& head, auto& speed) {
+            auto view = reg.view<Position, SnakeHead, SnakeStats, Speed, PlayerTag>();
+            view.each([&](auto entity, auto& pos, auto& head, auto& stats, auto& speed) {
 
-                float targetSpeed = (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && head.energyAccumulator > 0)
+                float targetSpeed = (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && stats.energyAccumulator > 0)
                     ? 320.f
                     : 180.f;
                 speed.value = speed.value + (targetSpeed - speed.value) * 10.f * ctx.time.dt;
@@ -0,0 +1,56 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include "Core/System.hpp"
+#include "Core/Context.hpp"
+#include "Core/ResourceManager.h"
+
+namespace Bocchi {
+    class LoadingRenderSystem : public System {
+    public:
+        void update(entt::registry& reg) override {
+            auto& ctx = reg.ctx().get<GameContext>();
+            auto* window = ctx.window.window;
+            if (!window || !ctx.window.uiView) return;
+
+            m_timer += ctx.time.dt;
+            float target = ctx.services.res ? ctx.services.res->loadProgress() : 1.f;
+            m_progress += (target - m_progress) * std::min(1.f, 10.f * ctx.time.dt);
+
+            window->setView(*ctx.window.uiView);
+            sf::Vector2f sz = ctx.window.windowSize;
+
+            sf::Color deepSpace(5, 5, 15);
+            sf::Color nebulaColor(20, 15, 30);
+            m_bg[0] = { {0.f, 0.f}, deepSpace };
+            m_bg[1] = { {sz.x, 0.f}, deepSpace };
+            m_bg[2] = { {sz.x, sz.y}, nebulaColor };
+            m_bg[3] = { {0.f, sz.y}, nebulaColor };
+            window->draw(m_bg);
+
+            sf::Vector2f barSize(sz.x * 0.5f, 12.f);
+            sf::Vector2f barPos((sz.x - barSize.x) / 2.f, sz.y * 0.6f);
+
+            m_frame.setSize(barSize);
+            m_frame.setPosition(barPos);
+            m_frame.setFillColor(sf::Color(30, 30, 45));
+            m_frame.setOutlineThickness(2.f);
+            m_frame.setOutlineColor(sf::Color(50, 50, 60));
+            window->draw(m_frame);
+
+            float pulse = std::sin(m_timer * 3.0f) * 0.5f + 0.5f;
+            m_fill.setSize({barSize.x * std::clamp(m_progress, 0.f, 1.f), barSize.y});
+            m_fill.setPosition(barPos);
+            m_fill.setFillColor(sf::Color(100, 149, 237, static_cast<sf::Uint8>(180 + 75 * pulse)));
+            window->draw(m_fill);
+        }
+
+    private:
+        sf::VertexArray m_bg{sf::Quads, 4};
+        sf::RectangleShape m_frame;
+        sf::RectangleShape m_fill;
+        float m_progress = 0.f;
+        float m_timer = 0.f;
+    };
+}
@@ -5,6 +5,7 @@
 #include "Core/System.hpp"
 #include "Core/Component.hpp"
 #include "Core/Context.hpp"
+#include "Core/FrameArena.h"
 
 namespace Bocchi {
     class PauseRenderSystem : public System {
@@ -15,14 +16,12 @@ namespace Bocchi {
             if (!window || !ctx.window.uiView) return;
 
             updateAnimation(ctx.state.isPaused, ctx.time.dt);
-            if (m_animFactor <= 0.0f) return;
 
             window->setView(*ctx.window.uiView);
-            sf::Vector2f sz = ctx.window.windowSize;
+            updateFrameCache(*window, ctx);
+            if (m_animFactor <= 0.0f) return;
 
-            sf::RectangleShape dim(sz);
-            dim.setFillColor(sf::Color(0, 0, 0, static_cast<sf::Uint8>(70 * m_animFactor)));
-            window->draw(dim);
+            sf::Vector2f sz = ctx.window.windowSize;
 
             float thickness = std::min(sz.x, sz.y) / 20.0f;
             float pulse = (ctx.state.isPaused && m_animFactor > 0.9f) ? (std::sin(m_timer * 2.5f) * 0.5f + 0.5f) : 0.0f;
@@ -31,19 +30,42 @@ namespace Bocchi {
             sf::Color edgeColor(180, 0, 0, alpha); 
             sf::Color innerColor(180, 0, 0, 0);
 
-            sf::VertexArray va(sf::Quads, 16);
-            drawEdge(va, 0, {0,0}, {thickness, thickness}, {0,sz.y}, {thickness, sz.y-thickness}, edgeColor, innerColor);
-            drawEdge(va, 4, {sz.x,0}, {sz.x-thickness, thickness}, {sz.x,sz.y}, {sz.x-thickness, sz.y-thickness}, edgeColor, innerColor);
-            drawEdge(va, 8, {0,0}, {thickness, thickness}, {sz.x,0}, {sz.x-thickness, thickness}, edgeColor, innerColor);
-            drawEdge(va, 12, {0,sz.y}, {thickness, sz.y-thickness}, {sz.x,sz.y}, {sz.x-thickness, sz.y-thickness}, edgeColor, innerColor);
+            // 遮罩 + 四条边，一批顶点从帧内存切出
+            FrameVector<sf::Vertex> va(20, sf::Vertex(), FrameAllocator<sf::Vertex>(*ctx.services.frameArena));
+            sf::Color dimColor(0, 0, 0, static_cast<sf::Uint8>(70 * m_animFactor));
+            drawEdge(va, 0, {0,0}, {sz.x,0}, {0,sz.y}, {sz.x,sz.y}, dimColor, dimColor);
+            drawEdge(va, 4, {0,0}, {thickness, thickness}, {0,sz.y}, {thickness, sz.y-thickness}, edgeColor, innerColor);
+            drawEdge(va, 8, {sz.x,0}, {sz.x-thickness, thickness}, {sz.x,sz.y}, {sz.x-thickness, sz.y-thickness}, edgeColor, innerColor);
+            drawEdge(va, 12, {0,0}, {thickness, thickness}, {sz.x,0}, {sz.x-thickness, thickness}, edgeColor, innerColor);
+            drawEdge(va, 16, {0,sz.y}, {thickness, sz.y-thickness}, {sz.x,sz.y}, {sz.x-thickness, sz.y-thickness}, edgeColor, innerColor);
 
-            window->draw(va);
+            window->draw(va.data(), va.size(), sf::Quads);
         }
 
     private:
         float m_animFactor = 0.0f;
         float m_timer = 0.0f;
 
+        sf::Texture m_frame;
+        sf::Sprite m_frameSprite;
+
+        // 暂停后的第一帧在叠加层之前抓取场景，之后只贴这张图，直到取消暂停
+        void updateFrameCache(sf::RenderWindow& window, GameContext& ctx) {
+            if (ctx.window.sceneFrozen) {
+                window.draw(m_frameSprite);
+                if (!ctx.state.isPaused) ctx.window.sceneFrozen = false;
+                return;
+            }
+            if (!ctx.state.isPaused) return;
+
+            sf::Vector2u size = window.getSize();
+            if (m_frame.getSize() != size && !m_frame.create(size.x, size.y)) return;
+            m_frame.update(window);
+            m_frameSprite.setTexture(m_frame, true);
+            m_frameSprite.setPosition(0.f, 0.f);
+            ctx.window.sceneFrozen = true;
+        }
+
         void updateAnimation(bool isPaused, float dt) {
             float fadeSpeed = 5.0f;
             m_timer += dt;
@@ -55,7 +77,8 @@ namespace Bocchi {
             }
         }
 
-        void drawEdge(sf::VertexArray& va, int i, sf::Vector2f o1, sf::Vector2f i1, sf::Vector2f o2, sf::Vector2f i2, sf::Color oc, sf::Color ic) {
+        template <typename Vertices>
+        void drawEdge(Vertices& va, int i, sf::Vector2f o1, sf::Vector2f i1, sf::Vector2f o2, sf::Vector2f i2, sf::Color oc, sf::Color ic) {
             va[i+0] = sf::Vertex(o1, oc); va[i+1] = sf::Vertex(i1, ic);
             va[i+2] = sf::Vertex(i2, ic); va[i+3] = sf::Vertex(o2, oc);
         }
@@ -14,61 +14,81 @@ namespace Bocchi {
         void update(entt::registry& reg) override {
             auto& ctx = reg.ctx().get<GameContext>();
             if (ctx.state.isPaused) return;
+            auto* foodSys = ctx.food.foodSystem;
 
-            auto headView = reg.view<SnakeHead, Position>();
+            auto headView = reg.view<SnakeHead, SnakePath, Position>(entt::exclude<SnakeSegments>);
             
-            headView.each([&](entt::entity headEnt, auto& head, auto& hPos) {
-                if (head.bodyEntities.empty()) return;
+            headView.each([&](auto& head, auto& path, auto& hPos) {
+                if (path.bodyEntities.empty()) return;
 
-                float spacing = head.currentRadius * 2.0f * head.spacingFactor;
-                
+                walkPath(head, path, hPos.val, path.bodyEntities.size(), [&](size_t bodyIdx, sf::Vector2f newBodyPos) {
+                    entt::entity bEnt = path.bodyEntities[bodyIdx];
+                    if (reg.valid(bEnt)) {
+                        auto& posComp = reg.get<Position>(bEnt);   
+                        if (foodSys) {
+                            foodSys->updateBodyInGrid(bEnt, posComp.val, newBodyPos);
+                        }
+                        posComp.val = newBodyPos;
+                    }
+                });
+            });
 
-                float accumulatedPathDist = 0.0f;
-                float targetDistForNextBody = spacing;
-                size_t bodyIdx = 0;
-                
-                sf::Vector2f currentPoint = hPos.val;
-                
-                for (auto it = head.pathHistory.rbegin(); it != head.pathHistory.rend(); ++it) {
-                    if (bodyIdx >= head.bodyEntities.size()) break;
+            // 紧凑身体：逐蛇线性写入位置数组，网格整体重建
+            if (foodSys) foodSys->clearSegmentGrid();
+            auto packedView = reg.view<SnakeHead, SnakePath, Position, SnakeSegments>();
+            packedView.each([&](entt::entity headEnt, auto& head, auto& path, auto& hPos, auto& segments) {
+                if (segments.empty()) return;
 
-                    sf::Vector2f nextPoint = *it;
-                    float dx = currentPoint.x - nextPoint.x;
-                    float dy = currentPoint.y - nextPoint.y;
-                    float segmentLen = std::sqrt(dx*dx + dy*dy);
+                walkPath(head, path, hPos.val, segments.size(), [&](size_t i, sf::Vector2f newPos) {
+                    segments.positions[i] = newPos;
+                    segments.flags[i] |= SnakeSegments::Placed;
+                });
+                if (!foodSys) return;
+                for (size_t i = 0; i < segments.size(); ++i) {
+                    foodSys->addSegmentToGrid(headEnt, static_cast<uint32_t>(i), segments.positions[i]);
+                }
+            });
+        }
 
-                    while (bodyIdx < head.bodyEntities.size() && 
-                           accumulatedPathDist + segmentLen >= targetDistForNextBody) {
-                        
-                        float localDist = targetDistForNextBody - accumulatedPathDist;
-                        float t = (segmentLen > 0.001f) ? (localDist / segmentLen) : 0.0f;
-                        
-                        sf::Vector2f newBodyPos = currentPoint + t * (nextPoint - currentPoint);
-                        
-                        entt::entity bEnt = head.bodyEntities[bodyIdx];
-                        if (reg.valid(bEnt)) {
-                            auto& posComp = reg.get<Position>(bEnt);   
-                            if (ctx.food.foodSystem) {
-                                ctx.food.foodSystem->updateBodyInGrid(bEnt, posComp.val, newBodyPos);
-                            }
-                            posComp.val = newBodyPos;
-                        }
+    private:
+        // 沿头部历史路径按间距采样 count 个身体位置，路径不够长时剩余节叠在路径末端
+        template <typename PlaceFn>
+        static void walkPath(const SnakeHead& head, const SnakePath& path, sf::Vector2f headPos, size_t count, PlaceFn&& place) {
+            float spacing = head.currentRadius * 2.0f * head.spacingFactor;
 
-                        bodyIdx++;
-                        targetDistForNextBody += spacing; 
-                    }
+            float accumulatedPathDist = 0.0f;
+            float targetDistForNextBody = spacing;
+            size_t bodyIdx = 0;
+            
+            sf::Vector2f currentPoint = headPos;
+            
+            for (auto it = path.pathHistory.rbegin(); it != path.pathHistory.rend(); ++it) {
+                if (bodyIdx >= count) break;
 
-                    accumulatedPathDist += segmentLen;
-                    currentPoint = nextPoint;
-                }
+                sf::Vector2f nextPoint = *it;
+                float dx = currentPoint.x - nextPoint.x;
+                float dy = currentPoint.y - nextPoint.y;
+                float segmentLen = std::sqrt(dx*dx + dy*dy);
 
-                for (; bodyIdx < head.bodyEntities.size(); ++bodyIdx) {
-                    entt::entity bEnt = head.bodyEntities[bodyIdx];
-                    if (reg.valid(bEnt)) {
-                        reg.get<Position>(bEnt).val = currentPoint;
-                    }
+                while (bodyIdx < count && 
+                       accumulatedPathDist + segmentLen >= targetDistForNextBody) {
+                    
+                    float localDist = targetDistForNextBody - accumulatedPathDist;
+                    float t = (segmentLen > 0.001f) ? (localDist / segmentLen) : 0.0f;
+                    
+                    place(bodyIdx, currentPoint + t * (nextPoint - currentPoint));
+
+                    bodyIdx++;
+                    targetDistForNextBody += spacing; 
                 }
-            });
+
+                accumulatedPathDist += segmentLen;
+                currentPoint = nextPoint;
+            }
+
+            for (; bodyIdx < count; ++bodyIdx) {
+                place(bodyIdx, currentPoint);
+            }
         }
     };
 
@@ -5,6 +5,8 @@
 #include "Core/Component.hpp"
 #include "Core/Context.hpp"
 #include "Core/Config.h"
+#include "Core/GrowthCurve.h"
+#include "Game/Builders/SegmentPool.hpp"
 #include <algorithm>
 
 namespace Bocchi {
@@ -14,43 +16,60 @@ namespace Bocchi {
         void update(entt::registry& registry) override {
             auto& ctx = registry.ctx().get<GameContext>();
             if (ctx.state.isPaused) return;
-            auto& config = Config::getInstance();
-
-            auto view = registry.view<SnakeHead, Position>();
-            view.each([&](auto entity, auto& head, auto& pos) {
-                float targetRadius = std::min(
-                    static_cast<float>(config.defaultSnakeRadius + (config.defaultSnakeRadius * std::pow(head.currentLength-5, 0.5f) * 0.3f)),
-                    config.maxRadius
-                );        
-                if (std::abs(head.currentRadius - targetRadius) > 0.1f) {
-                    head.currentRadius += (targetRadius - head.currentRadius) * 2.0f * ctx.time.dt;
-                }
+            const auto& curve = growthCurve(registry);
 
-            float deltaR = std::max(0.f, head.currentRadius - config.defaultSnakeRadius);
-            head.turnSpeed = 8.f * (0.4f + 0.6f* std::exp(-0.02f * deltaR));
+            // 生成新身体节：只处理本帧发出成长事件的蛇，长度变化后按新长度查表更新属性
+            auto& events = ctx.events.growth;
+            for (const auto& event : events) {
+                entt::entity entity = event.snake;
+                if (!registry.valid(entity)) continue;
+                auto& stats = registry.get<SnakeStats>(entity);
+                if (stats.pendingGrowth <= 0) continue;   // 同一帧的重复事件
 
-                while (head.pendingGrowth > 0) {
-                    spawnBodySegment(registry, entity, head);
-                    head.pendingGrowth--;
+                auto& head = registry.get<SnakeHead>(entity);
+                auto* segments = registry.try_get<SnakeSegments>(entity);
+                auto& path = registry.get<SnakePath>(entity);
+                while (stats.pendingGrowth > 0) {
+                    if (segments) spawnPackedSegment(*segments, head, stats);
+                    else spawnBodySegment(registry, entity, head, stats, path);
+                    stats.pendingGrowth--;
                 }
+                applyStage(curve.at(stats.currentLength), head, registry.get<MagnetRange>(entity));
+                registry.emplace_or_replace<RadiusEasing>(entity);
+            }
+            events.clear();
 
-                if (registry.all_of<CircleCollider>(entity)) {
-                    registry.get<CircleCollider>(entity).radius = head.currentRadius;
+            // 半径缓动：只遍历还没到目标半径的蛇，到位后摘掉标记
+            auto view = registry.view<SnakeHead, SnakeStats, CircleCollider, RadiusEasing>();
+            view.each([&](auto entity, auto& head, auto& stats, auto& collider) {
+                float targetRadius = curve.at(stats.currentLength).radius;
+                if (std::abs(head.currentRadius - targetRadius) > 0.1f) {
+                    head.currentRadius += (targetRadius - head.currentRadius) * 2.0f * ctx.time.dt;
+                } else {
+                    registry.remove<RadiusEasing>(entity);
                 }
-
+                collider.radius = head.currentRadius;
             });
         }
 
+        static void applyStage(const GrowthStage& stage, SnakeHead& head, MagnetRange& magnet) {
+            head.turnSpeed = stage.turnSpeed;
+            head.spacingFactor = stage.spacingFactor;
+            magnet.range = stage.magnetRange;
+        }
+
     private:
-        void spawnBodySegment(entt::registry& reg, entt::entity headOwner, SnakeHead& head) {
-            auto bodyEnt = reg.create();
-            
-            int newIdx = ++head.currentLength; 
-            reg.emplace<SnakeBody>(bodyEnt, headOwner, newIdx);        
-            reg.emplace<Position>(bodyEnt, sf::Vector2f(-10000.f, -10000.f));
-            reg.emplace<CircleCollider>(bodyEnt, head.currentRadius * 0.9f);
-
-            head.bodyEntities.push_back(bodyEnt);
+        void spawnBodySegment(entt::registry& reg, entt::entity headOwner, const SnakeHead& head, SnakeStats& stats, SnakePath& path) {
+            int newIdx = ++stats.currentLength; 
+            auto bodyEnt = segmentPool(reg).acquire(reg, headOwner, newIdx,
+                                                    sf::Vector2f(-10000.f, -10000.f), head.currentRadius * 0.9f);
+
+            path.bodyEntities.push_back(bodyEnt);
+        }
+
+        void spawnPackedSegment(SnakeSegments& segments, const SnakeHead& head, SnakeStats& stats) {
+            ++stats.currentLength;
+            segments.push(sf::Vector2f(-10000.f, -10000.f), head.currentRadius * 0.9f);
         }
     };
 
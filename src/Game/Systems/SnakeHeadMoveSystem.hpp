@@ -18,9 +18,9 @@ namespace Bocchi {
             const float DEG_TO_RAD = PI / 180.f;
             const float RAD_TO_DEG = 180.f / PI;
 
-            auto view = reg.view<Position, Rotation, SnakeHead, Speed>();
+            auto view = reg.view<Position, PrevPosition, Rotation, SnakeHead, Speed>();
 
-            view.each([&](auto entity, auto& pos, auto& rot, auto& head, auto& speed) {
+            view.each([&](auto entity, auto& pos, auto& prevPos, auto& rot, auto& head, auto& speed) {
 
                 float currentRad = rot.angle * DEG_TO_RAD;
                 float targetRad = head.targetAngle * DEG_TO_RAD;
@@ -39,6 +39,7 @@ namespace Bocchi {
                 rot.angle = currentRad * RAD_TO_DEG;
 
                 sf::Vector2f oldPos = pos.val;
+                prevPos.val = oldPos;
                 pos.val.x += std::cos(currentRad) * speed.value * dt;
                 pos.val.y += std::sin(currentRad) * speed.value * dt;
 
@@ -47,23 +48,25 @@ namespace Bocchi {
                 float distMoved = std::sqrt(dx * dx + dy * dy);
                 
                 head.distAccumulator += distMoved;
-                const float samplingDist = 5.0f;
-
-                if (head.distAccumulator >= samplingDist) {
-
-                    head.pathHistory.push_back(pos.val);
-                    head.distAccumulator = 0.0f;
-
-                    if (head.pathHistory.size() > 2000) {
-                        head.pathHistory.erase(head.pathHistory.begin());
-                    }
-                }
-
                 
                 if (head.spawnProtectionTime > 0) {
                     head.spawnProtectionTime -= ctx.time.dt;
                 }
             });
+
+            // 路径采样只在走够距离时触碰 SnakePath，运动循环不拉取路径数据
+            const float samplingDist = 5.0f;
+            auto pathView = reg.view<Position, SnakeHead, SnakePath>();
+            pathView.each([&](auto& pos, auto& head, auto& path) {
+                if (head.distAccumulator < samplingDist) return;
+
+                path.pathHistory.push_back(pos.val);
+                head.distAccumulator = 0.0f;
+
+                if (path.pathHistory.size() > 2000) {
+                    path.pathHistory.erase(path.pathHistory.begin());
+                }
+            });
         }
     };
 
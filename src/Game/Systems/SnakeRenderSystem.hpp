@@ -1,9 +1,15 @@
 #pragma once
 #include <cmath>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
 #include <entt/entt.hpp>
 #include "Core/System.hpp"
 #include "Core/Component.hpp"
 #include "Core/Context.hpp"
+#include "Core/Config.h"
+#include "FoodSpawnSystem.hpp"
 #include <SFML/Graphics.hpp>
 
 namespace Bocchi {
@@ -13,10 +19,18 @@ namespace Bocchi {
         sf::CircleShape m_shield;
 
     public:
+        // 纯色蛇身体的绘制方式：Circles (描边圆片), Ribbon (单次绘制的三角带)
+        enum class BodyStyle { Circles, Ribbon };
+
+        SnakeRenderSystem(BodyStyle bodyStyle = BodyStyle::Circles)
+            : m_bodyStyle(bodyStyle) {}
+
+        void setBodyStyle(BodyStyle bodyStyle) { m_bodyStyle = bodyStyle; }
+
         void update(entt::registry& reg) override {
             auto& ctx = reg.ctx().get<GameContext>();
             auto* window = ctx.window.window;
-            if (!window) return;
+            if (!window || ctx.window.sceneFrozen) return;
 
             if (ctx.window.worldView) window->setView(*ctx.window.worldView);
 
@@ -31,28 +45,60 @@ namespace Bocchi {
                 viewBounds.height = size.y + 100.f;
             }
 
-            auto bodyView = reg.view<SnakeBody, Position>();
-            for (auto entity : bodyView) {
-                const auto& pos = bodyView.get<Position>(entity);
-                if (hasView && !viewBounds.contains(pos.val)) continue;
+            const auto& config = Config::getInstance();
+            const float pixelScale = computePixelScale(*window, ctx);
+
+            collectVisibleBodies(reg, ctx, hasView ? &viewBounds : nullptr);
+            clearBatches();
+
+            // 同一条蛇的渲染属性每帧只解析一次；换蛇时先把上一条蛇攒下的批次画掉，
+            // 保证各档 LOD 的蛇都按遍历顺序叠放
+            entt::entity currentOwner = entt::null;
+            OwnerStyle style;
+            bool ownerValid = false;
+            const VisibleBody* prev = nullptr;
+            for (const auto& vb : m_visibleBodies) {
+                if (vb.owner != currentOwner) {
+                    flushBatches(*window);
+                    clearBatches();
+                    currentOwner = vb.owner;
+                    ownerValid = resolveOwner(reg, ctx, vb.owner, style);
+                    prev = nullptr;
+
+                    // 整条蛇一次性画成网格，跳过它的其余身体节
+                    if (ownerValid && m_bodyStyle == BodyStyle::Ribbon && !style.texture &&
+                        style.radius * pixelScale >= config.lodFlatPixelRadius) {
+                        drawRibbon(*window, reg, vb.owner, style);
+                        ownerValid = false;
+                    }
+                }
+                if (!ownerValid) continue;
 
-                const auto& body = bodyView.get<SnakeBody>(entity);
-                if (reg.valid(body.headOwner)) {
-                    const auto& headData = reg.get<SnakeHead>(body.headOwner);
-                    drawInternal(*window, ctx, headData.bodyID, headData.color, pos.val, 0.0f, headData.currentRadius, false);
+                float screenRadius = style.radius * pixelScale;
+                if (screenRadius >= config.lodFlatPixelRadius) {
+                    drawInternal(*window, style.texture, style.color, vb.pos, 0.0f, style.radius, false);
+                } else if (screenRadius >= config.lodTrailPixelRadius || !prev || prev->segmentIndex + 1 != vb.segmentIndex) {
+                    appendFlat(style, vb.pos);
+                } else {
+                    appendTrail(style, prev->pos, vb.pos);
                 }
+                prev = &vb;
             }
+            flushBatches(*window);
 
-            auto headView = reg.view<SnakeHead, Position, Rotation>();
+            auto headView = reg.view<SnakeHead, SnakeSkin, Position, Rotation>();
             for (auto entity : headView) {
                 const auto& pos = headView.get<Position>(entity);
                 if (hasView && !viewBounds.contains(pos.val)) continue;
 
                 const auto& head = headView.get<SnakeHead>(entity);
+                const auto& skin = headView.get<SnakeSkin>(entity);
                 const auto& rot = headView.get<Rotation>(entity);
 
-                if (head.headID != ResID::head_shantianliang) drawInternal(*window, ctx, head.headID, head.color, pos.val, rot.angle + 90.f, head.currentRadius, true);
-                else drawInternal(*window, ctx, head.headID, head.color, pos.val, rot.angle, head.currentRadius, true);
+                const sf::Texture* headTex = resolveTexture(ctx, skin.headID);
+                bool withEyes = head.currentRadius * pixelScale >= config.lodEyePixelRadius;
+                if (skin.headID != ResID::head_shantianliang) drawInternal(*window, headTex, skin.color, pos.val, rot.angle + 90.f, head.currentRadius, withEyes);
+                else drawInternal(*window, headTex, skin.color, pos.val, rot.angle, head.currentRadius, withEyes);
 
                 if (head.spawnProtectionTime > 0) {
                     float shieldRadius = head.currentRadius * head.currentRadius / 2.f;
@@ -80,15 +126,257 @@ namespace Bocchi {
         }
 
     private:
+        struct VisibleBody {
+            entt::entity owner;
+            int segmentIndex;
+            sf::Vector2f pos;
+        };
+
+        struct OwnerStyle {
+            const sf::Texture* texture = nullptr;
+            sf::Color color;
+            sf::Color trailColor;
+            float radius = 0.f;
+        };
+
+        std::vector<VisibleBody> m_visibleBodies;
+
+        BodyStyle m_bodyStyle;
+        static constexpr int RIBBON_CAP_SEGMENTS = 8;
+        sf::VertexArray m_ribbon{sf::TriangleStrip};
+        std::vector<sf::Vector2f> m_ribbonPoints;
+
+        // 以头部+身体位置为中心线生成带圆头的三角带；圆头用 (圆心, 弧点) 交替写入，
+        // 中间产生的退化三角形不会被光栅化
+        void drawRibbon(sf::RenderWindow& window, entt::registry& reg, entt::entity owner, const OwnerStyle& style) {
+            const auto& path = reg.get<SnakePath>(owner);
+            m_ribbonPoints.clear();
+            m_ribbonPoints.push_back(reg.get<Position>(owner).val);
+            if (const auto* segments = reg.try_get<SnakeSegments>(owner)) {
+                m_ribbonPoints.insert(m_ribbonPoints.end(), segments->positions.begin(), segments->positions.end());
+            }
+            for (auto bEnt : path.bodyEntities) {
+                if (reg.valid(bEnt)) m_ribbonPoints.push_back(reg.get<Position>(bEnt).val);
+            }
+            if (m_ribbonPoints.size() < 2) return;
+
+            const float r = style.radius;
+            const sf::Color c = style.color;
+            const size_t n = m_ribbonPoints.size();
+            m_ribbon.clear();
+
+            auto dirAt = [&](size_t i) {
+                sf::Vector2f a = m_ribbonPoints[i > 0 ? i - 1 : 0];
+                sf::Vector2f b = m_ribbonPoints[i + 1 < n ? i + 1 : n - 1];
+                sf::Vector2f d = b - a;
+                float len = std::sqrt(d.x * d.x + d.y * d.y);
+                return len > 0.001f ? d / len : sf::Vector2f(1.f, 0.f);
+            };
+            auto arcPoint = [&](sf::Vector2f center, sf::Vector2f t, sf::Vector2f nrm, float deg) {
+                float rad = deg * 3.14159265f / 180.f;
+                return center + (t * std::cos(rad) + nrm * std::sin(rad)) * r;
+            };
+
+            // 头端圆头：从左侧绕过前端到右侧
+            sf::Vector2f d0 = dirAt(0);
+            sf::Vector2f n0(-d0.y, d0.x);
+            sf::Vector2f p0 = m_ribbonPoints.front();
+            m_ribbon.append(sf::Vertex(p0 + n0 * r, c));
+            for (int k = 1; k < RIBBON_CAP_SEGMENTS; ++k) {
+                m_ribbon.append(sf::Vertex(p0, c));
+                m_ribbon.append(sf::Vertex(arcPoint(p0, -d0, n0, 90.f - 180.f * k / RIBBON_CAP_SEGMENTS), c));
+            }
+            m_ribbon.append(sf::Vertex(p0, c));
+            m_ribbon.append(sf::Vertex(p0 - n0 * r, c));
+
+            for (size_t i = 0; i < n; ++i) {
+                sf::Vector2f d = dirAt(i);
+                sf::Vector2f nrm(-d.y, d.x);
+                m_ribbon.append(sf::Vertex(m_ribbonPoints[i] + nrm * r, c));
+                m_ribbon.append(sf::Vertex(m_ribbonPoints[i] - nrm * r, c));
+            }
+
+            // 尾端圆头：从右侧绕过末端回到左侧
+            sf::Vector2f dn = dirAt(n - 1);
+            sf::Vector2f nn(-dn.y, dn.x);
+            sf::Vector2f pn = m_ribbonPoints.back();
+            for (int k = 1; k < RIBBON_CAP_SEGMENTS; ++k) {
+                m_ribbon.append(sf::Vertex(pn, c));
+                m_ribbon.append(sf::Vertex(arcPoint(pn, dn, nn, -90.f + 180.f * k / RIBBON_CAP_SEGMENTS), c));
+            }
+            m_ribbon.append(sf::Vertex(pn, c));
+            m_ribbon.append(sf::Vertex(pn + nn * r, c));
+
+            window.draw(m_ribbon);
+        }
+
+        // LOD 批次：小尺寸身体合并为纯色多边形 / 贴图四边形 / 拖尾条带
+        static constexpr int FLAT_SEGMENTS = 8;
+        sf::VertexArray m_flatBatch{sf::Triangles};
+        sf::VertexArray m_trailBatch{sf::Quads};
+        std::unordered_map<const sf::Texture*, sf::VertexArray> m_texturedBatches;
+        std::unordered_map<ResID, sf::Color> m_trailColorCache;
+
+        float computePixelScale(const sf::RenderWindow& window, const GameContext& ctx) const {
+            if (!ctx.window.worldView) return 1.f;
+            float viewWidth = ctx.window.worldView->getSize().x;
+            if (viewWidth <= 0.f) return 1.f;
+            return static_cast<float>(window.getSize().x) / viewWidth;
+        }
+
+        void clearBatches() {
+            m_flatBatch.clear();
+            m_trailBatch.clear();
+            for (auto& batch : m_texturedBatches) batch.second.clear();
+        }
+
+        void flushBatches(sf::RenderWindow& window) {
+            if (m_trailBatch.getVertexCount() > 0) window.draw(m_trailBatch);
+            if (m_flatBatch.getVertexCount() > 0) window.draw(m_flatBatch);
+            for (auto& [tex, batch] : m_texturedBatches) {
+                if (batch.getVertexCount() == 0) continue;
+                sf::RenderStates states;
+                states.texture = tex;
+                window.draw(batch, states);
+            }
+        }
+
+        void appendFlat(const OwnerStyle& style, sf::Vector2f pos) {
+            float r = style.radius;
+            if (style.texture) {
+                auto& batch = m_texturedBatches[style.texture];
+                if (batch.getPrimitiveType() != sf::Quads) batch.setPrimitiveType(sf::Quads);
+                sf::Vector2f ts(static_cast<float>(style.texture->getSize().x), static_cast<float>(style.texture->getSize().y));
+                float halfH = r * ts.y / ts.x;
+                batch.append(sf::Vertex({pos.x - r, pos.y - halfH}, {0.f, 0.f}));
+                batch.append(sf::Vertex({pos.x + r, pos.y - halfH}, {ts.x, 0.f}));
+                batch.append(sf::Vertex({pos.x + r, pos.y + halfH}, {ts.x, ts.y}));
+                batch.append(sf::Vertex({pos.x - r, pos.y + halfH}, {0.f, ts.y}));
+                return;
+            }
+
+            static const std::array<sf::Vector2f, FLAT_SEGMENTS + 1> unitCircle = []() {
+                std::array<sf::Vector2f, FLAT_SEGMENTS + 1> pts{};
+                for (int i = 0; i <= FLAT_SEGMENTS; ++i) {
+                    float a = i * 2.f * 3.14159265f / FLAT_SEGMENTS;
+                    pts[i] = {std::cos(a), std::sin(a)};
+                }
+                return pts;
+            }();
+            for (int i = 0; i < FLAT_SEGMENTS; ++i) {
+                m_flatBatch.append(sf::Vertex(pos, style.color));
+                m_flatBatch.append(sf::Vertex(pos + unitCircle[i] * r, style.color));
+                m_flatBatch.append(sf::Vertex(pos + unitCircle[i + 1] * r, style.color));
+            }
+        }
+
+        void appendTrail(const OwnerStyle& style, sf::Vector2f from, sf::Vector2f to) {
+            sf::Vector2f d = to - from;
+            float len = std::sqrt(d.x * d.x + d.y * d.y);
+            if (len < 0.001f) return;
+            sf::Vector2f n(-d.y / len * style.radius, d.x / len * style.radius);
+            sf::Color c = style.trailColor;
+            m_trailBatch.append(sf::Vertex(from + n, c));
+            m_trailBatch.append(sf::Vertex(to + n, c));
+            m_trailBatch.append(sf::Vertex(to - n, c));
+            m_trailBatch.append(sf::Vertex(from - n, c));
+        }
+
+        // 贴图蛇的拖尾取贴图平均色，每个资源只回读一次（按 ResID 缓存，贴图被淘汰重载后仍有效）
+        sf::Color trailColorFor(ResID id, const sf::Texture* tex, sf::Color fallback) {
+            if (!tex) return fallback;
+            auto it = m_trailColorCache.find(id);
+            if (it != m_trailColorCache.end()) return it->second;
+
+            sf::Image img = tex->copyToImage();
+            sf::Vector2u size = img.getSize();
+            unsigned long long r = 0, g = 0, b = 0, n = 0;
+            for (unsigned y = 0; y < size.y; y += 4) {
+                for (unsigned x = 0; x < size.x; x += 4) {
+                    sf::Color px = img.getPixel(x, y);
+                    if (px.a < 128) continue;
+                    r += px.r; g += px.g; b += px.b; ++n;
+                }
+            }
+            sf::Color avg = n ? sf::Color(static_cast<sf::Uint8>(r / n), static_cast<sf::Uint8>(g / n), static_cast<sf::Uint8>(b / n)) : fallback;
+            m_trailColorCache[id] = avg;
+            return avg;
+        }
+
+        // 通过身体网格只取视口内的身体节，按 (所属蛇, 节序号) 排序以便逐蛇解析
+        void collectVisibleBodies(entt::registry& reg, GameContext& ctx, const sf::FloatRect* viewBounds) {
+            m_visibleBodies.clear();
+            auto* foodSys = ctx.food.foodSystem;
+
+            if (foodSys && viewBounds) {
+                int minX, minY, maxX, maxY;
+                foodSys->getCellRange(*viewBounds, minX, minY, maxX, maxY);
+                for (int y = minY; y <= maxY; ++y) {
+                    for (int x = minX; x <= maxX; ++x) {
+                        for (auto bEnt : foodSys->getBodiesInCell(x, y)) {
+                            if (!reg.valid(bEnt)) continue;
+                            const auto& pos = reg.get<Position>(bEnt).val;
+                            if (!viewBounds->contains(pos)) continue;
+                            const auto& body = reg.get<SnakeBody>(bEnt);
+                            m_visibleBodies.push_back({body.headOwner, body.segmentIndex, pos});
+                        }
+                        for (const auto& ref : foodSys->getSegmentsInCell(x, y)) {
+                            const auto* segments = reg.try_get<SnakeSegments>(ref.owner);
+                            if (!segments || ref.index >= segments->size()) continue;
+                            const auto& pos = segments->positions[ref.index];
+                            if (!viewBounds->contains(pos)) continue;
+                            m_visibleBodies.push_back({ref.owner, static_cast<int>(ref.index), pos});
+                        }
+                    }
+                }
+            } else {
+                auto bodyView = reg.view<SnakeBody, Position>(entt::exclude<ParkedSegment>);
+                for (auto entity : bodyView) {
+                    const auto& pos = bodyView.get<Position>(entity).val;
+                    if (viewBounds && !viewBounds->contains(pos)) continue;
+                    const auto& body = bodyView.get<SnakeBody>(entity);
+                    m_visibleBodies.push_back({body.headOwner, body.segmentIndex, pos});
+                }
+                auto packedView = reg.view<SnakeSegments>();
+                for (auto owner : packedView) {
+                    const auto& segments = packedView.get<SnakeSegments>(owner);
+                    for (size_t i = 0; i < segments.size(); ++i) {
+                        if (viewBounds && !viewBounds->contains(segments.positions[i])) continue;
+                        m_visibleBodies.push_back({owner, static_cast<int>(i), segments.positions[i]});
+                    }
+                }
+            }
+
+            std::sort(m_visibleBodies.begin(), m_visibleBodies.end(), [](const VisibleBody& a, const VisibleBody& b) {
+                if (a.owner != b.owner) return a.owner < b.owner;
+                return a.segmentIndex < b.segmentIndex;
+            });
+        }
+
+        bool resolveOwner(entt::registry& reg, GameContext& ctx, entt::entity owner, OwnerStyle& out) {
+            if (!reg.valid(owner)) return false;
+            const auto* headData = reg.try_get<SnakeHead>(owner);
+            const auto* skin = reg.try_get<SnakeSkin>(owner);
+            if (!headData || !skin) return false;
+            out.texture = resolveTexture(ctx, skin->bodyID);
+            out.color = skin->color;
+            out.trailColor = trailColorFor(skin->bodyID, out.texture, skin->color);
+            out.radius = headData->currentRadius;
+            return true;
+        }
+
+        const sf::Texture* resolveTexture(GameContext& ctx, ResID id) {
+            if (id == ResID::NONE || !ctx.services.res) return nullptr;
+            return &ctx.services.res->get<sf::Texture>(id);
+        }
 
-        void drawInternal(sf::RenderWindow& window, GameContext& ctx, ResID id, sf::Color color,
-                          sf::Vector2f pos, float rotation, float radius, bool isHead) 
+        void drawInternal(sf::RenderWindow& window, const sf::Texture* tex, sf::Color color,
+                          sf::Vector2f pos, float rotation, float radius, bool withEyes) 
         {
-            if (id != ResID::NONE && ctx.services.res) {
-                auto& tex = ctx.services.res->get<sf::Texture>(id);
+            if (tex) {
                 static sf::Sprite brush;
-                brush.setTexture(tex, true);
-                sf::Vector2u size = tex.getSize();
+                brush.setTexture(*tex, true);
+                sf::Vector2u size = tex->getSize();
                 brush.setOrigin(size.x / 2.f, size.y / 2.f);
                 float scale = (radius * 2.0f) / static_cast<float>(size.x);
                 brush.setScale(scale, scale);
@@ -107,7 +395,7 @@ namespace Bocchi {
                 window.draw(circle);
             }
 
-            if (isHead && id == ResID::NONE) {
+            if (withEyes && !tex) {
                 drawEyes(window, pos, rotation, radius);
             }
         }
@@ -0,0 +1,58 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include "Core/System.hpp"
+#include "Core/Context.hpp"
+#include "Game/Systems/FoodSpawnSystem.hpp"
+
+namespace Bocchi {
+
+    // 检查世界初始化时预留的容量是否被突破；每项只在首次超出时报告一次
+    class StorageBudgetSystem : public System {
+    public:
+        // 预留组件存储并登记检查项
+        template <typename T>
+        void reserve(entt::registry& reg, const char* name, size_t count) {
+            auto& storage = reg.storage<T>();
+            storage.reserve(count);
+            m_budgets.push_back({name, &storage, count});
+        }
+
+        void reserveFood(FoodSpawnSystem* foodSystem, size_t count) {
+            if (!foodSystem) return;
+            foodSystem->reserveFoods(count);
+            m_foodSystem = foodSystem;
+            m_foodBudget = count;
+        }
+
+        void update(entt::registry&) override {
+            for (auto& b : m_budgets) {
+                if (b.reported || b.storage->size() <= b.reserved) continue;
+                report(b.name, b.storage->size(), b.reserved);
+                b.reported = true;
+            }
+            if (m_foodSystem && !m_foodReported && m_foodSystem->foodSlots() > m_foodBudget) {
+                report("FoodItem", m_foodSystem->foodSlots(), m_foodBudget);
+                m_foodReported = true;
+            }
+        }
+
+    private:
+        struct Budget {
+            const char* name;
+            const entt::sparse_set* storage;
+            size_t reserved;
+            bool reported = false;
+        };
+
+        static void report(const char* name, size_t size, size_t reserved) {
+            std::cerr << "[storage] " << name << " exceeded reservation: "
+                      << size << " > " << reserved << " (check Config)" << std::endl;
+        }
+
+        std::vector<Budget> m_budgets;
+        FoodSpawnSystem* m_foodSystem = nullptr;
+        size_t m_foodBudget = 0;
+        bool m_foodReported = false;
+    };
+}
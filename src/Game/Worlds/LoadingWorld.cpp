@@ -0,0 +1,17 @@
+#include "LoadingWorld.h"
+
+namespace Bocchi{
+    void LoadingWorld::init(const GameContext& ctx){
+        if (auto* existing = m_registry.ctx().find<GameContext>()) {
+            *existing = ctx;
+        } else {
+            m_registry.ctx().emplace<GameContext>(ctx);
+        }
+
+        addSystem<AssetLoadSystem>(WorldType::ClassicMode);
+        addSystem<LoadingRenderSystem>();
+    }
+
+    void LoadingWorld::quit() {
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "Core/World.hpp"
+#include "Game/Systems/AssetLoadSystem.hpp"
+#include "Game/Systems/LoadingRenderSystem.hpp"
+
+namespace Bocchi{
+    class LoadingWorld : public World {
+    public:
+        virtual void init(const GameContext& ctx) override;
+        virtual void quit() override;
+    };
+}
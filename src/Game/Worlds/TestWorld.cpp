@@ -11,13 +11,16 @@ namespace Bocchi{
         }
 
         auto& gctx = m_registry.ctx().get<GameContext>();
+        auto& config = Config::getInstance();
+        // 拥有型 group 必须在任何身体节创建之前建立
+        bodyGroup(m_registry);
+        // 成长曲线表在开局前一次性算好
+        growthCurve(m_registry);
 
         
 
-        auto foodSystem = std::make_unique<FoodSpawnSystem>(gctx.window.mapSize.x, gctx.window.mapSize.y);
-        m_foodSystem = foodSystem.get();
+        m_foodSystem = &addSystem<FoodSpawnSystem>(gctx.window.mapSize.x, gctx.window.mapSize.y);
         gctx.food.foodSystem = m_foodSystem;
-        m_systems.push_back(std::move(foodSystem));
 
         addSystem<ClassicBackgroundRenderSystem>();
         addSystem<AiSpawnSystem>();
@@ -26,16 +29,18 @@ namespace Bocchi{
         addSystem<AiControlSystem>();
         addSystem<SnakeHeadMoveSystem>();
         addSystem<SnakeGrowthSystem>();
+        addSystem<BodyOrderSystem>();
         addSystem<SnakeBodyMoveSystem>();
         addSystem<CollisionSystem>();
         addSystem<DeathSystem>();
         addSystem<CameraSystem>();
+        addSystem<AudioSystem>();
         
         addSystem<FoodRenderSystem>();
-        addSystem<SnakeRenderSystem>();
+        addSystem<SnakeRenderSystem>(config.ribbonSnakeBodies ? SnakeRenderSystem::BodyStyle::Ribbon
+                                                               : SnakeRenderSystem::BodyStyle::Circles);
         addSystem<PauseRenderSystem>();
-
-        auto& config = Config::getInstance();
+        reserveStorage(addSystem<StorageBudgetSystem>());
 
         std::mt19937 m_rng{ std::random_device{}() };
 
@@ -57,6 +62,38 @@ namespace Bocchi{
         );
     }
 
+    // 按最大蛇数和预期长度一次性预留，避免开局几分钟内存储反复扩容
+    void TestWorld::reserveStorage(StorageBudgetSystem& budget) {
+        const auto& config = Config::getInstance();
+        size_t snakes = static_cast<size_t>(config.maxAICount) + 1;
+        size_t segments = snakes * static_cast<size_t>(config.expectedSnakeLength);
+        // 紧凑身体不为身体节创建实体，数组容量在建蛇时预留
+        size_t segmentEntities = config.packedSnakeBodies ? 0 : segments;
+
+        budget.reserve<entt::entity>(m_registry, "entity", snakes + segmentEntities);
+        budget.reserve<Position>(m_registry, "Position", snakes + segmentEntities);
+        budget.reserve<CircleCollider>(m_registry, "CircleCollider", snakes + segmentEntities);
+        budget.reserve<SnakeBody>(m_registry, "SnakeBody", segmentEntities);
+        budget.reserve<ColorComponent>(m_registry, "ColorComponent", segmentEntities);
+        budget.reserve<ParkedSegment>(m_registry, "ParkedSegment", segmentEntities);
+        segmentPool(m_registry).reserve(segmentEntities);
+        budget.reserve<SnakeHead>(m_registry, "SnakeHead", snakes);
+        budget.reserve<SnakePath>(m_registry, "SnakePath", snakes);
+        budget.reserve<SnakeStats>(m_registry, "SnakeStats", snakes);
+        budget.reserve<SnakeSkin>(m_registry, "SnakeSkin", snakes);
+        budget.reserve<PrevPosition>(m_registry, "PrevPosition", snakes);
+        budget.reserve<Rotation>(m_registry, "Rotation", snakes);
+        budget.reserve<Speed>(m_registry, "Speed", snakes);
+        budget.reserve<MagnetRange>(m_registry, "MagnetRange", snakes);
+        budget.reserve<RadiusEasing>(m_registry, "RadiusEasing", snakes);
+        budget.reserve<SkinHandles>(m_registry, "SkinHandles", snakes);
+        budget.reserve<AiTag>(m_registry, "AiTag", snakes);
+        if (config.packedSnakeBodies) budget.reserve<SnakeSegments>(m_registry, "SnakeSegments", snakes);
+
+        // 地图食物上限加上所有身体节点死亡掉落
+        budget.reserveFood(m_foodSystem, static_cast<size_t>(config.maxTotalFood) + segments);
+    }
+
     void TestWorld::quit() {
         m_foodSystem = nullptr;
     }
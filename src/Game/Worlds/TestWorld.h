@@ -15,6 +15,9 @@
 #include "Game/Systems/DeathSystem.hpp"
 #include "Game/Systems/AiControlSystem.hpp"
 #include "Game/Systems/AiSpawnSystem.hpp"
+#include "Game/Systems/AudioSystem.hpp"
+#include "Game/Systems/StorageBudgetSystem.hpp"
+#include "Game/Systems/BodyOrderSystem.hpp"
 
 #include "Game/Builders/EntityBuilder.hpp"
 
@@ -24,6 +27,8 @@ namespace Bocchi{
         virtual void init(const GameContext& ctx) override;
         virtual void quit() override;
     private:
+        void reserveStorage(StorageBudgetSystem& budget);
+
         class FoodSpawnSystem* m_foodSystem = nullptr;
     };
 }
@@ -1,5 +1,13 @@
 #include "Core/App.h"
-int main() {
+#include "Core/StartupTrace.h"
+#include "Game/Systems/CollisionSelfTest.hpp"
+#include <cstring>
+#include <iostream>
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--collision-selftest") == 0) return Bocchi::CollisionSelfTest::run(std::cout);
+    }
+    Bocchi::StartupTrace::getInstance().parseArgs(argc, argv);
     Bocchi::App app;
-    app.run();
-}
\ No newline at end of file
+    return app.run();
+}
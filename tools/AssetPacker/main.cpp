@@ -0,0 +1,96 @@
+// 构建时资源打包工具：按 ASSET_MANIFEST 解码所有贴图与音效，写出单个 .pak 文件
+// 用法: AssetPacker <输出路径>   （工作目录需为包含 assets/ 的源码根目录）
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "Core/ResourceManager.h"
+#include "Core/AssetArchive.h"
+#include "Core/TextureFit.h"
+
+using namespace Bocchi;
+
+namespace {
+    struct PackedAsset {
+        AssetArchive::Entry entry{};
+        std::vector<unsigned char> bytes;
+    };
+
+    bool packTexture(const AssetEntry& src, PackedAsset& out) {
+        sf::Image image;
+        if (!image.loadFromFile(src.path)) return false;
+        // 构建时按最大绘制尺寸缩小，运行时直接映射上传
+        fitImage(image, src.maxDrawSize);
+        sf::Vector2u size = image.getSize();
+        const unsigned char* pixels = image.getPixelsPtr();
+        out.entry.width = size.x;
+        out.entry.height = size.y;
+        out.bytes.assign(pixels, pixels + static_cast<size_t>(size.x) * size.y * 4);
+        return true;
+    }
+
+    bool packSound(const AssetEntry& src, PackedAsset& out) {
+        sf::InputSoundFile file;
+        if (!file.openFromFile(src.path)) return false;
+        std::vector<sf::Int16> samples(static_cast<size_t>(file.getSampleCount()));
+        samples.resize(static_cast<size_t>(file.read(samples.data(), samples.size())));
+        if (samples.empty()) return false;
+        out.entry.width = file.getChannelCount();
+        out.entry.height = file.getSampleRate();
+        const auto* raw = reinterpret_cast<const unsigned char*>(samples.data());
+        out.bytes.assign(raw, raw + samples.size() * sizeof(sf::Int16));
+        return true;
+    }
+
+    uint64_t alignUp(uint64_t v) {
+        return (v + AssetArchive::DATA_ALIGN - 1) / AssetArchive::DATA_ALIGN * AssetArchive::DATA_ALIGN;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* outPath = argc > 1 ? argv[1] : AssetArchive::DEFAULT_PATH;
+
+    std::vector<PackedAsset> packed;
+    for (const auto& src : ASSET_MANIFEST) {
+        PackedAsset asset;
+        asset.entry.id = static_cast<uint32_t>(src.id);
+        asset.entry.kind = static_cast<uint32_t>(src.kind);
+        bool ok = (src.kind == AssetKind::Texture) ? packTexture(src, asset) : packSound(src, asset);
+        if (!ok) {
+            std::cerr << "AssetPacker: failed to decode " << src.path << std::endl;
+            return 1;
+        }
+        packed.push_back(std::move(asset));
+    }
+
+    AssetArchive::Header header{};
+    std::memcpy(header.magic, AssetArchive::MAGIC, 4);
+    header.version = AssetArchive::VERSION;
+    header.entryCount = static_cast<uint32_t>(packed.size());
+
+    uint64_t offset = alignUp(sizeof(header) + sizeof(AssetArchive::Entry) * packed.size());
+    for (auto& asset : packed) {
+        asset.entry.offset = offset;
+        asset.entry.size = asset.bytes.size();
+        offset = alignUp(offset + asset.entry.size);
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "AssetPacker: cannot write " << outPath << std::endl;
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& asset : packed) {
+        out.write(reinterpret_cast<const char*>(&asset.entry), sizeof(asset.entry));
+    }
+    for (const auto& asset : packed) {
+        out.seekp(static_cast<std::streamoff>(asset.entry.offset));
+        out.write(reinterpret_cast<const char*>(asset.bytes.data()), static_cast<std::streamsize>(asset.bytes.size()));
+    }
+
+    std::cout << "AssetPacker: wrote " << packed.size() << " assets to " << outPath << std::endl;
+    return out.good() ? 0 : 1;
+}